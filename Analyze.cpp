@@ -0,0 +1,125 @@
+// Qt Libraries
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <QString>
+#include <QTextStream>
+
+// Standard Libraries
+#include <algorithm>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+// Personal Libraries
+#include "HexParameterSweep.hpp"
+
+// A path without wildcard is taken as is. Otherwise the files under the directory preceding the first wildcard are
+// matched against the whole pattern, where '*' and '?' never cross a '/'.
+static std::vector<QString> Expand(const QString& pattern)
+{
+	const auto wildcard = pattern.indexOf(QRegularExpression("[*?[]"));
+	
+	if (wildcard < 0)
+		return { pattern };
+	
+	const auto root = QDir(pattern.left(pattern.lastIndexOf('/', wildcard) + 1)).absolutePath();
+	const QRegularExpression expression(QRegularExpression::wildcardToRegularExpression(QDir::cleanPath(QDir::current().absoluteFilePath(pattern))));
+	
+	std::vector<QString> files;
+	QDirIterator it(root, QDir::Files, QDirIterator::Subdirectories);
+	
+	while (it.hasNext())
+	{
+		const auto filePath = QFileInfo(it.next()).absoluteFilePath();
+		
+		if (expression.match(filePath).hasMatch())
+			files.push_back(filePath);
+	}
+	
+	return files;
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc < 4)
+	{
+		std::cerr << "Usage: " << argv[0] << " <tp> <sl> <day files or patterns>... [--threads N] [--summary] [--json] [--output file]" << std::endl;
+		return 1;
+	}
+	
+	const auto takeProfit = QString(argv[1]).toDouble();
+	const auto stopLoss = QString(argv[2]).toDouble();
+	
+	if (takeProfit < 0.25 or stopLoss < 0.)
+	{
+		std::cerr << "TP must be at least 0.25 and SL at least 0." << std::endl;
+		return 1;
+	}
+	
+	auto numberOfThreads = std::max(std::thread::hardware_concurrency(), 1u);
+	auto keepDays = true;
+	auto json = false;
+	QString outputPath;
+	std::vector<QString> filePaths;
+	
+	for (auto i = 3; i < argc; ++i)
+	{
+		const QString argument = argv[i];
+		
+		if (argument == "--threads" and i + 1 < argc)
+			numberOfThreads = std::max(QString(argv[++i]).toUInt(), 1u);
+		else if (argument == "--summary")
+			keepDays = false;
+		else if (argument == "--json")
+			json = true;
+		else if (argument == "--output" and i + 1 < argc)
+			outputPath = argv[++i];
+		else if (argument.startsWith("--"))
+		{
+			std::cerr << "Unknown argument [" << argv[i] << "]." << std::endl;
+			return 1;
+		}
+		else
+		{
+			const auto matches = Expand(argument);
+			filePaths.insert(filePaths.end(), matches.begin(), matches.end());
+		}
+	}
+	
+	std::sort(filePaths.begin(), filePaths.end());
+	filePaths.erase(std::unique(filePaths.begin(), filePaths.end()), filePaths.end());
+	
+	if (filePaths.empty())
+	{
+		std::cerr << "No day file matches." << std::endl;
+		return 1;
+	}
+	
+	HexParameterSweep analyzer(filePaths, { takeProfit }, { stopLoss }, keepDays);
+	analyzer.run(std::min(numberOfThreads, static_cast<quint32>(filePaths.size())));
+	
+	for (const auto& filePath : analyzer.failures())
+		std::cerr << "File [" << filePath.toStdString() << "] could not be read." << std::endl;
+	
+	QFile outputFile(outputPath);
+	
+	if (!outputPath.isEmpty() and !outputFile.open(QIODevice::WriteOnly | QIODevice::Text))
+	{
+		std::cerr << "Failed to open [" << outputPath.toStdString() << "]." << std::endl;
+		return 1;
+	}
+	
+	QTextStream fileStream(&outputFile);
+	QTextStream standardStream(stdout);
+	auto& stream = (outputPath.isEmpty() ? standardStream : fileStream);
+	
+	if (json)
+		analyzer.writeJson(stream);
+	else
+		analyzer.write(stream);
+	
+	return 0;
+}
@@ -0,0 +1,358 @@
+// Qt Libraries
+#include <QApplication>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QGraphicsScene>
+#include <QImage>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPainter>
+#include <QString>
+#include <QTextStream>
+
+// Standard Libraries
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+// Personal Libraries
+#include "HexBinaryDay.hpp"
+#include "HexDayAnalysis.hpp"
+#include "HexForwardScan.hpp"
+#include "HexReplayDriver.hpp"
+#include "HexTextParser.hpp"
+#include "QCandlestickItem.hpp"
+
+static bool LegacyLoad(const QString& filePath, HexDayAnalysis& analysis)
+{
+	QFile dataFile(filePath);
+	
+	if (!dataFile.open(QIODevice::ReadOnly | QIODevice::Text))
+		return false;
+	
+	QTextStream fileReader(&dataFile);
+	const auto minData = fileReader.readLine().split(' ');
+	const auto maxData = fileReader.readLine().split(' ');
+	
+	if (minData.size() != 4u or maxData.size() != 4u)
+		return false;
+	
+	analysis.setMinima(minData[0u].toDouble(), minData[1u].toDouble(), minData[2u].toDouble(), minData[3u].toDouble());
+	analysis.setMaxima(maxData[0u].toDouble(), maxData[1u].toDouble(), maxData[2u].toDouble(), maxData[3u].toDouble());
+	analysis.clear();
+	
+	while (!fileReader.atEnd())
+	{
+		const auto data = fileReader.readLine().split(' ');
+		
+		if (data.size() != 2u)
+			return false;
+		
+		analysis.saveCandlestick(data[0u].toDouble(), data[1u].toDouble());
+	}
+	
+	return true;
+}
+
+template <typename Function>
+static qreal MeanMilliseconds(quint32 iterations, Function&& function)
+{
+	const auto start = std::chrono::steady_clock::now();
+	
+	for (auto i = 0u; i < iterations; ++i)
+		function();
+	
+	const std::chrono::duration<qreal, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+	return elapsed.count()/iterations;
+}
+
+// Checks every forward scan kernel the CPU runs against the scalar one on every day file under the directory, from
+// every start and for a few TP/SL pairs, and reports the throughput of each in candlesticks per microsecond.
+static int ScanDays(const QString& directory)
+{
+	static const std::array<std::pair<qreal, qreal>, 3u> limits = { { { 2., 3. }, { 9., 15. }, { 40., 40. } } };
+	
+	const auto kernels = HexForwardScan::Kernels();
+	QDirIterator it(directory, { "*.txt", "*.hexd" }, QDir::Files, QDirIterator::Subdirectories);
+	std::vector<qreal> kernelTimes(kernels.size(), 0.);
+	std::vector<quint32> mismatches(kernels.size(), 0u);
+	quint64 scanned = 0u;
+	auto days = 0u;
+	
+	while (it.hasNext())
+	{
+		const auto filePath = it.next();
+		HexColumns columns;
+		
+		if (filePath.endsWith(".hexd") ? !HexBinaryDay::Load(filePath, columns) : HexTextParser::Parse(filePath, columns).error != HexParseReport::None)
+			continue;
+		
+		const auto size = static_cast<quint32>(columns.lows.size());
+		std::vector<quint32> expected(size);
+		std::vector<quint32> found(size);
+		
+		for (const auto& [tp, sl] : limits)
+		{
+			for (auto k = 0u; k < kernels.size(); ++k)
+			{
+				auto& results = (k == 0u ? expected : found);
+				
+				kernelTimes[k] += MeanMilliseconds(1u, [&](void)
+				{
+					for (auto i = 0u; i < size; ++i)
+						results[i] = kernels[k].second(columns.lows.data(), columns.highs.data(), i + 1u, size, columns.highs[i] - sl, columns.highs[i] + tp);
+				});
+				
+				if (k == 0u)
+					continue;
+				
+				for (auto i = 0u; i < size; ++i)
+					mismatches[k] += (expected[i] != found[i] ? 1u : 0u);
+			}
+			
+			for (auto i = 0u; i < size; ++i)
+				scanned += std::min(expected[i], size) - std::min(i + 1u, size);
+		}
+		
+		++days;
+	}
+	
+	auto failed = false;
+	std::cout << days << " day(s) scanned." << std::endl;
+	
+	for (auto k = 0u; k < kernels.size(); ++k)
+	{
+		std::cout << kernels[k].first << " scan: " << scanned/(kernelTimes[k]*1'000.) << " candlesticks/us";
+		
+		if (k != 0u)
+			std::cout << ", " << mismatches[k] << " mismatch(es) with the scalar scan";
+		
+		std::cout << std::endl;
+		failed = failed or mismatches[k] != 0u;
+	}
+	
+	return (failed ? 1 : 0);
+}
+
+static bool WriteJson(const QString& jsonPath, const QJsonArray& results)
+{
+	QFile jsonFile(jsonPath);
+	
+	if (!jsonFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+	{
+		std::cerr << "File [" << jsonPath.toStdString() << "] could not be written." << std::endl;
+		return false;
+	}
+	
+	const QJsonObject document { { "kernel", HexForwardScan::KernelName() }, { "results", results } };
+	jsonFile.write(QJsonDocument(document).toJson());
+	return true;
+}
+
+// Replays day files through the streaming path at 1x, 10x, 100x or maximum speed and reports the p50 and p99
+// latencies from arrival to study and to strips, with the sustained candlesticks per second. A directory stands for
+// every day file under it.
+static int ReplayDays(int argc, char *argv[])
+{
+	QStringList filePaths;
+	QString jsonPath;
+	QString speedName = "max";
+	auto count = 0u;
+	
+	for (auto i = 2; i < argc; ++i)
+	{
+		const QString argument = argv[i];
+		
+		if (argument == "--speed" and i + 1 < argc)
+			speedName = argv[++i];
+		else if (argument == "--candles" and i + 1 < argc)
+			count = QString(argv[++i]).toUInt();
+		else if (argument == "--json" and i + 1 < argc)
+			jsonPath = argv[++i];
+		else if (QFileInfo(argument).isDir())
+		{
+			QDirIterator it(argument, { "*.txt", "*.hexd" }, QDir::Files, QDirIterator::Subdirectories);
+			
+			while (it.hasNext())
+				filePaths.append(it.next());
+		}
+		else
+			filePaths.append(argument);
+	}
+	
+	if (filePaths.isEmpty())
+	{
+		QDirIterator it("input/", { "*.txt", "*.hexd" }, QDir::Files, QDirIterator::Subdirectories);
+		
+		while (it.hasNext())
+			filePaths.append(it.next());
+	}
+	
+	if (!QStringList({ "1", "10", "100", "max" }).contains(speedName))
+	{
+		std::cerr << "Speed must be 1, 10, 100 or max." << std::endl;
+		return 1;
+	}
+	
+	filePaths.sort();
+	const auto speed = (speedName == "max" ? 0. : speedName.toDouble());
+	QJsonArray results;
+	auto failed = false;
+	
+	for (const auto& filePath : filePaths)
+	{
+		HexReplayDriver driver;
+		
+		if (!driver.load(filePath))
+		{
+			std::cerr << "File [" << filePath.toStdString() << "] could not be parsed." << std::endl;
+			failed = true;
+			continue;
+		}
+		
+		const auto report = driver.run(speed, count, 200u, 1u, 9., 15.);
+		const auto rate = report.numberOfCandlesticks/std::max(report.seconds, 1e-9);
+		
+		std::cout << QFileInfo(filePath).fileName().toStdString() << "  replay x" << speedName.toStdString() << ": " << report.numberOfCandlesticks << " candlesticks, "
+			<< report.numberOfUpdates << " updates, " << rate << " candlesticks/s, study p50 " << report.studyLatency.percentile(0.5) << " us p99 "
+			<< report.studyLatency.percentile(0.99) << " us, strips p50 " << report.chartLatency.percentile(0.5) << " us p99 " << report.chartLatency.percentile(0.99) << " us" << std::endl;
+		
+		results.append(QJsonObject { { "file", QFileInfo(filePath).fileName() }, { "benchmark", "replay/x" + speedName },
+						{ "candlesticks", static_cast<qint64>(report.numberOfCandlesticks) }, { "updates", static_cast<qint64>(report.numberOfUpdates) },
+						{ "seconds", report.seconds }, { "candlesticksPerSecond", rate },
+						{ "studyP50us", report.studyLatency.percentile(0.5) }, { "studyP99us", report.studyLatency.percentile(0.99) },
+						{ "stripsP50us", report.chartLatency.percentile(0.5) }, { "stripsP99us", report.chartLatency.percentile(0.99) } });
+	}
+	
+	if (!jsonPath.isEmpty() and !WriteJson(jsonPath, results))
+		return 1;
+	
+	return (failed ? 1 : 0);
+}
+
+static void Record(QJsonArray& results, const QString& filePath, const QString& name, quint32 iterations, qreal milliseconds)
+{
+	std::cout << QFileInfo(filePath).fileName().toStdString() << "  " << name.toStdString() << ": " << milliseconds << " ms" << std::endl;
+	results.append(QJsonObject { { "file", QFileInfo(filePath).fileName() }, { "benchmark", name }, { "iterations", static_cast<qint64>(iterations) }, { "ms", milliseconds } });
+}
+
+// Times everything the chart does with one day: loading, studying and recalling a study, sampling (one-strip scroll steps and jumps across
+// the day), the break and drop report, and painting the chart item into an offscreen image.
+static bool BenchDay(const QString& filePath, quint32 iterations, QJsonArray& results)
+{
+	static const std::array<std::pair<qreal, qreal>, 3u> limits = { { { 2., 3. }, { 9., 15. }, { 40., 40. } } };
+	
+	HexDayAnalysis analysis;
+	
+	if (!LegacyLoad(filePath, analysis) or HexTextParser::Parse(filePath, analysis).error != HexParseReport::None)
+	{
+		std::cerr << "File [" << filePath.toStdString() << "] could not be parsed." << std::endl;
+		return false;
+	}
+	
+	Record(results, filePath, "load/legacy", iterations, MeanMilliseconds(iterations, [&](void) { LegacyLoad(filePath, analysis); }));
+	Record(results, filePath, "load/parser", iterations, MeanMilliseconds(iterations, [&](void) { HexTextParser::Parse(filePath, analysis); }));
+	
+	const auto binaryPath = filePath.left(filePath.size() - 4) + ".hexd";
+	
+	if (QFileInfo::exists(binaryPath))
+		Record(results, filePath, "load/binary", iterations, MeanMilliseconds(iterations, [&](void) { HexBinaryDay::Load(binaryPath, analysis); }));
+	
+	// Studies are memoized per TP and SL, so each iteration nudges TP by one ulp to run a whole study, as a new TP does.
+	for (const auto& [tp, sl] : limits)
+	{
+		auto nudgedTp = tp;
+		Record(results, filePath, "study/tp=" + QString::number(tp) + ",sl=" + QString::number(sl), iterations, MeanMilliseconds(iterations, [&](void) { analysis.study(nudgedTp = std::nextafter(nudgedTp, 1'000.), sl); }));
+	}
+	
+	analysis.study(9., 15.);
+	Record(results, filePath, "study/recall", iterations, MeanMilliseconds(iterations, [&](void) { analysis.study(9., 15.); }));
+	
+	const auto size = static_cast<quint32>(HexTextParser::Parse(filePath, analysis).lineCount);
+	analysis.study(9., 15.);
+	
+	for (const auto timeUnit : { 1u, 15u, 180u })
+	{
+		for (const auto requested : { 200u, 2'000u })
+		{
+			const auto numberOfCandlesticks = std::min(requested, size/timeUnit);
+			const auto name = "/tu=" + QString::number(timeUnit) + ",nc=" + QString::number(numberOfCandlesticks);
+			auto position = size/2u;
+			auto step = 0u;
+			
+			Record(results, filePath, "extract-scroll" + name, iterations, MeanMilliseconds(iterations, [&](void) { analysis.extractSample(position = (position + timeUnit) % size, numberOfCandlesticks, timeUnit, 9., 15.); }));
+			Record(results, filePath, "extract-jump" + name, iterations, MeanMilliseconds(iterations, [&](void) { analysis.extractSample((step++ % 2u)*size, numberOfCandlesticks, timeUnit, 9., 15.); }));
+		}
+	}
+	
+	Record(results, filePath, "sumUp", iterations, MeanMilliseconds(iterations, [&](void) { analysis.sumUpBreaksAndDrops("(00:00:00)"); }));
+	
+	for (const auto numberOfCandlesticks : { 200u, 2'000u })
+	{
+		const auto strips = analysis.extractSample(size/2u, numberOfCandlesticks, 1u, 9., 15.);
+		QGraphicsScene scene;
+		const auto chart = new QCandlestickItem();
+		scene.addItem(chart);
+		
+		QImage image(1'600, 900, QImage::Format_ARGB32_Premultiplied);
+		
+		Record(results, filePath, "render/nc=" + QString::number(numberOfCandlesticks), iterations, MeanMilliseconds(iterations, [&](void)
+		{
+			chart->setStrips(strips, size/2u, 1., numberOfCandlesticks <= 150u);
+			image.fill(Qt::white);
+			QPainter painter(&image);
+			scene.render(&painter, image.rect(), chart->boundingRect(), Qt::IgnoreAspectRatio);
+		}));
+	}
+	
+	return true;
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc == 3 and QString(argv[1]) == "--scan")
+		return ScanDays(argv[2]);
+	
+	if (argc >= 2 and QString(argv[1]) == "--replay")
+		return ReplayDays(argc, argv);
+	
+	if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+		qputenv("QT_QPA_PLATFORM", "offscreen");
+	
+	QApplication app(argc, argv);
+	QStringList filePaths;
+	QString jsonPath;
+	auto iterations = 20u;
+	
+	for (auto i = 1; i < argc; ++i)
+	{
+		const QString argument = argv[i];
+		
+		if (argument == "--json" and i + 1 < argc)
+			jsonPath = argv[++i];
+		else if (argument == "--iterations" and i + 1 < argc)
+			iterations = std::max(QString(argv[++i]).toUInt(), 1u);
+		else
+			filePaths.append(argument);
+	}
+	
+	if (filePaths.isEmpty())
+		filePaths = { "input/MNQ/MNQ_20241121_15h30_22h00.txt", "input/MES/MES_20241121_15h30_22h00.txt" };
+	
+	QJsonArray results;
+	auto failed = false;
+	
+	for (const auto& filePath : filePaths)
+		failed = (!BenchDay(filePath, iterations, results) or failed);
+	
+	if (!jsonPath.isEmpty() and !WriteJson(jsonPath, results))
+		return 1;
+	
+	return (failed ? 1 : 0);
+}
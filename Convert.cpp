@@ -0,0 +1,59 @@
+// Qt Libraries
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+
+// Standard Libraries
+#include <iostream>
+
+// Personal Libraries
+#include "HexBinaryDay.hpp"
+#include "HexTextParser.hpp"
+
+static bool ConvertFile(const QString& textPath, const QString& binaryPath)
+{
+	HexColumns columns;
+	columns.lows.reserve(23'400u);
+	columns.highs.reserve(23'400u);
+	
+	if (HexTextParser::Parse(textPath, columns).error != HexParseReport::None)
+		return false;
+	
+	return HexBinaryDay::Save(binaryPath, columns.minima, columns.maxima, columns.lows, columns.highs);
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc < 2 or argc > 3)
+	{
+		std::cerr << "Usage: " << argv[0] << " <input directory> [output directory]" << std::endl;
+		return 1;
+	}
+	
+	const QDir inputDir(argv[1]);
+	const QDir outputDir(argc == 3 ? argv[2] : argv[1]);
+	auto converted = 0u;
+	auto failed = 0u;
+	
+	QDirIterator it(inputDir.path(), { "*.txt" }, QDir::Files, QDirIterator::Subdirectories);
+	
+	while (it.hasNext())
+	{
+		const auto textPath = it.next();
+		const auto relativePath = inputDir.relativeFilePath(textPath);
+		const auto binaryPath = outputDir.filePath(relativePath.left(relativePath.size() - 4) + ".hexd");
+		
+		if (!QDir().mkpath(QFileInfo(binaryPath).path()) or !ConvertFile(textPath, binaryPath))
+		{
+			std::cerr << "File [" << textPath.toStdString() << "] could not be converted." << std::endl;
+			++failed;
+			continue;
+		}
+		
+		++converted;
+	}
+	
+	std::cout << converted << " file(s) converted, " << failed << " failure(s)." << std::endl;
+	return (failed == 0u ? 0 : 1);
+}
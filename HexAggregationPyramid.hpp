@@ -0,0 +1,141 @@
+#ifndef __HEX_AGGREGATION_PYRAMID_HPP__
+#define __HEX_AGGREGATION_PYRAMID_HPP__
+
+// Standard Libraries
+#include <array>
+#include <vector>
+
+// Personal Libraries
+#include "HexCoreTypes.hpp"
+
+// Aggregates of aligned blocks of 5, 15, 30, 60 and 180 candlesticks, each level built from the one below. A range is
+// covered greedily by the largest aligned blocks that fit, so a strip of any time unit costs a few additions instead
+// of one per second. Outcome counts depend on the study, so the pyramid is rebuilt with it; while streaming, it is
+// extended block by block and follows the outcomes that change.
+class HexAggregationPyramid
+{
+	private:
+	
+		static constexpr std::array<std::uint32_t, 5u>	BlockSizes = { 5u, 15u, 30u, 60u, 180u };
+		
+		std::array<std::vector<HexAggregate>, 5u>	levels;
+	
+	public:
+	
+		inline HexAggregate			aggregate(const HexCandlesticks&, std::uint32_t, std::uint32_t) const;
+		inline void				build(const HexCandlesticks&);
+		inline void				clear(void);
+		inline void				extend(const HexCandlesticks&);
+		inline void				recount(std::uint32_t, char, char);
+};
+
+HexAggregate HexAggregationPyramid::aggregate(const HexCandlesticks& candlesticks, std::uint32_t start, std::uint32_t length) const
+{
+	HexAggregate result;
+	const auto end = start + length;
+	auto position = start;
+	
+	while (position < end)
+	{
+		auto level = static_cast<std::int32_t>(HexAggregationPyramid::BlockSizes.size()) - 1;
+		
+		while (level >= 0)
+		{
+			const auto blockSize = HexAggregationPyramid::BlockSizes[static_cast<std::uint32_t>(level)];
+			
+			if (position % blockSize == 0u and position + blockSize <= end and position/blockSize < HexAggregationPyramid::levels[static_cast<std::uint32_t>(level)].size())
+				break;
+			
+			--level;
+		}
+		
+		if (level < 0)
+		{
+			result.add(candlesticks, position++);
+			continue;
+		}
+		
+		const auto blockSize = HexAggregationPyramid::BlockSizes[static_cast<std::uint32_t>(level)];
+		result += HexAggregationPyramid::levels[static_cast<std::uint32_t>(level)][position/blockSize];
+		position += blockSize;
+	}
+	
+	return result;
+}
+
+void HexAggregationPyramid::build(const HexCandlesticks& candlesticks)
+{
+	const auto size = static_cast<std::uint32_t>(candlesticks.size());
+	auto& base = HexAggregationPyramid::levels[0u];
+	base.assign(size/HexAggregationPyramid::BlockSizes[0u], HexAggregate());
+	
+	for (auto i = 0u; i < base.size()*HexAggregationPyramid::BlockSizes[0u]; ++i)
+		base[i/HexAggregationPyramid::BlockSizes[0u]].add(candlesticks, i);
+	
+	for (auto k = 1u; k < HexAggregationPyramid::levels.size(); ++k)
+	{
+		const auto ratio = HexAggregationPyramid::BlockSizes[k]/HexAggregationPyramid::BlockSizes[k - 1u];
+		const auto& previous = HexAggregationPyramid::levels[k - 1u];
+		auto& current = HexAggregationPyramid::levels[k];
+		current.assign(size/HexAggregationPyramid::BlockSizes[k], HexAggregate());
+		
+		for (auto i = 0u; i < current.size()*ratio; ++i)
+			current[i/ratio] += previous[i];
+	}
+}
+
+void HexAggregationPyramid::clear(void)
+{
+	for (auto& level : HexAggregationPyramid::levels)
+		level.clear();
+}
+
+// Adds the blocks completed by candlesticks appended since the last build or extension.
+void HexAggregationPyramid::extend(const HexCandlesticks& candlesticks)
+{
+	const auto size = static_cast<std::uint32_t>(candlesticks.size());
+	auto& base = HexAggregationPyramid::levels[0u];
+	
+	while (base.size() < size/HexAggregationPyramid::BlockSizes[0u])
+	{
+		HexAggregate block;
+		const auto first = static_cast<std::uint32_t>(base.size())*HexAggregationPyramid::BlockSizes[0u];
+		
+		for (auto i = first; i < first + HexAggregationPyramid::BlockSizes[0u]; ++i)
+			block.add(candlesticks, i);
+		
+		base.push_back(block);
+	}
+	
+	for (auto k = 1u; k < HexAggregationPyramid::levels.size(); ++k)
+	{
+		const auto ratio = HexAggregationPyramid::BlockSizes[k]/HexAggregationPyramid::BlockSizes[k - 1u];
+		const auto& previous = HexAggregationPyramid::levels[k - 1u];
+		auto& current = HexAggregationPyramid::levels[k];
+		
+		while (current.size() < size/HexAggregationPyramid::BlockSizes[k])
+		{
+			HexAggregate block;
+			const auto first = static_cast<std::uint32_t>(current.size())*ratio;
+			
+			for (auto i = first; i < first + ratio; ++i)
+				block += previous[i];
+			
+			current.push_back(block);
+		}
+	}
+}
+
+// Follows the outcome change of one candlestick in every block that already covers it.
+void HexAggregationPyramid::recount(std::uint32_t index, char from, char to)
+{
+	for (auto k = 0u; k < HexAggregationPyramid::levels.size(); ++k)
+	{
+		const auto block = index/HexAggregationPyramid::BlockSizes[k];
+		
+		if (block < HexAggregationPyramid::levels[k].size())
+			HexAggregationPyramid::levels[k][block].recount(from, to);
+	}
+}
+
+#endif
@@ -0,0 +1,121 @@
+#ifndef __HEX_BINARY_DAY_HPP__
+#define __HEX_BINARY_DAY_HPP__
+
+// Qt Libraries
+#include <QFile>
+#include <QString>
+
+// Standard Libraries
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+// Personal Libraries
+#include "HexDayAnalysis.hpp"
+
+// Layout of a .hexd file (native byte order): the header below, then numberOfCandlesticks lows and
+// numberOfCandlesticks highs, both as qint32 counts of 0.25 ticks.
+struct HexBinaryHeader
+{
+	std::array<char, 4u>		magic = { 'H', 'E', 'X', 'D' };
+	quint32				version = 1u;
+	quint32				numberOfCandlesticks = 0u;
+	quint32				reserved = 0u;
+	
+	std::array<qreal, 4u>		minima = { };
+	std::array<qreal, 4u>		maxima = { };
+};
+
+class HexBinaryDay
+{
+	public:
+	
+		template <typename Sink>
+		inline static bool		Load(const QString&, Sink&);
+		inline static bool		Save(const QString&, const std::array<qreal, 4u>&, const std::array<qreal, 4u>&, const std::vector<qreal>&, const std::vector<qreal>&);
+		inline static bool		ToTicks(qreal, qint32&);
+};
+
+// The sink is a HexDayAnalysis or HexColumns, like for HexTextParser.
+template <typename Sink>
+bool HexBinaryDay::Load(const QString& filePath, Sink& analysis)
+{
+	QFile dataFile(filePath);
+	
+	if (!dataFile.open(QIODevice::ReadOnly))
+		return false;
+	
+	const auto fileSize = static_cast<quint64>(dataFile.size());
+	
+	if (fileSize < sizeof(HexBinaryHeader))
+		return false;
+	
+	const auto data = dataFile.map(0, dataFile.size());
+	
+	if (data == nullptr)
+		return false;
+	
+	HexBinaryHeader header;
+	std::memcpy(&header, data, sizeof(HexBinaryHeader));
+	
+	if (header.magic != HexBinaryHeader().magic or header.version != 1u)
+		return false;
+	
+	if (fileSize != sizeof(HexBinaryHeader) + 2u*sizeof(qint32)*header.numberOfCandlesticks)
+		return false;
+	
+	const auto lows = reinterpret_cast<const qint32*>(data + sizeof(HexBinaryHeader));
+	const auto highs = lows + header.numberOfCandlesticks;
+	
+	analysis.setMinima(header.minima[0u], header.minima[1u], header.minima[2u], header.minima[3u]);
+	analysis.setMaxima(header.maxima[0u], header.maxima[1u], header.maxima[2u], header.maxima[3u]);
+	analysis.clear();
+	analysis.saveCandlesticks(lows, highs, header.numberOfCandlesticks);
+	return true;
+}
+
+bool HexBinaryDay::Save(const QString& filePath, const std::array<qreal, 4u>& minima, const std::array<qreal, 4u>& maxima, const std::vector<qreal>& lows, const std::vector<qreal>& highs)
+{
+	if (lows.size() != highs.size())
+		return false;
+	
+	HexBinaryHeader header;
+	header.numberOfCandlesticks = static_cast<quint32>(lows.size());
+	header.minima = minima;
+	header.maxima = maxima;
+	
+	std::vector<qint32> ticks(2u*lows.size());
+	
+	for (auto i = 0u; i < lows.size(); ++i)
+	{
+		if (!HexBinaryDay::ToTicks(lows[i], ticks[i]) or !HexBinaryDay::ToTicks(highs[i], ticks[lows.size() + i]))
+			return false;
+	}
+	
+	QFile dataFile(filePath);
+	
+	if (!dataFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+		return false;
+	
+	const auto headerSize = static_cast<qint64>(sizeof(HexBinaryHeader));
+	const auto ticksSize = static_cast<qint64>(ticks.size()*sizeof(qint32));
+	
+	if (dataFile.write(reinterpret_cast<const char*>(&header), headerSize) != headerSize)
+		return false;
+	
+	return dataFile.write(reinterpret_cast<const char*>(ticks.data()), ticksSize) == ticksSize;
+}
+
+bool HexBinaryDay::ToTicks(qreal price, qint32& ticks)
+{
+	const auto rounded = std::round(price*4.);
+	
+	if (rounded*0.25 != price or std::abs(rounded) > static_cast<qreal>(std::numeric_limits<qint32>::max()))
+		return false;
+	
+	ticks = static_cast<qint32>(rounded);
+	return true;
+}
+
+#endif
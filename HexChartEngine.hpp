@@ -0,0 +1,283 @@
+#ifndef __HEX_CHART_ENGINE_HPP__
+#define __HEX_CHART_ENGINE_HPP__
+
+// Qt Libraries
+#include <QByteArray>
+#include <QFileInfo>
+#include <QString>
+#include <QtConcurrent/QtConcurrentMap>
+
+// Standard Libraries
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+// Personal Libraries
+#include "HexDayAnalysis.hpp"
+#include "HexDayArchive.hpp"
+#include "HexStudyCache.hpp"
+
+// Everything the chart needs from the data side: the archive, the current day and its study. It is not thread-safe
+// on purpose: QChartInterface only calls it from its single-threaded worker pool, which keeps the calls ordered. The
+// panes of a synchronized draw are studied in parallel, but the archive and the study cache stay on the engine thread.
+class HexChartEngine
+{
+	private:
+	
+		HexDayArchive				archive;
+		HexStudyCache				studyCache;
+		QString					currentPath;
+		qint32					archiveIndex = -1;
+		std::shared_ptr<HexDayAnalysis>		currentDay = std::make_shared<HexDayAnalysis>();
+		std::shared_ptr<HexDayAnalysis>		liveDay;
+		
+		std::shared_ptr<HexDayAnalysis>		companionsOf;
+		std::vector<std::shared_ptr<HexDayAnalysis>>	companionDays;
+		std::vector<QString>			companionPaths;
+		
+		inline static quint32			EndSecond(const HexDayAnalysis&, const std::vector<HexStrip>&, quint32);
+		
+		inline void				findCompanions(void);
+	
+	public:
+	
+		inline HexChartResult			appendLive(const std::vector<std::pair<qreal, qreal>>&, quint32, quint32, qreal, qreal, bool);
+		inline std::vector<HexChartResult>	draw(quint32, quint32, quint32, qreal, qreal, const QString&, bool);
+		inline HexLoadResult			load(const QString&);
+		inline HexLoadResult			startLive(const HexColumns&, const QString&);
+		inline HexLoadResult			switchDay(qint32);
+		inline std::vector<std::vector<HexStrip>>	tiles(const std::vector<quint32>&, quint32, quint32, qreal, qreal);
+};
+
+// Candlesticks always go to the live day; the newest strips are only drawn while it is the current day, so loading
+// or switching days during a session leaves the chart alone. No candlestick count means appending only. When the
+// chart already shows the previous live sample, only the strips that changed since are sent.
+HexChartResult HexChartEngine::appendLive(const std::vector<std::pair<qreal, qreal>>& candlesticks, quint32 numberOfCandlesticks, quint32 timeUnit, qreal tp, qreal sl, bool changesOnly)
+{
+	HexChartResult result;
+	
+	if (HexChartEngine::liveDay == nullptr)
+		return result;
+	
+	for (const auto& [low, high] : candlesticks)
+		HexChartEngine::liveDay->appendCandlestick(low, high);
+	
+	if (HexChartEngine::liveDay != HexChartEngine::currentDay or HexChartEngine::liveDay->size() == 0u or numberOfCandlesticks == 0u)
+		return result;
+	
+	if (changesOnly)
+		result.strips = HexChartEngine::liveDay->extractLiveChanges(numberOfCandlesticks, timeUnit, tp, sl, result.firstStrip);
+	else
+		result.strips = HexChartEngine::liveDay->extractLiveSample(numberOfCandlesticks, timeUnit, tp, sl);
+	
+	result.endSecond = HexChartEngine::EndSecond(*HexChartEngine::liveDay, result.strips, timeUnit);
+	result.completed = true;
+	return result;
+}
+
+// One result per pane, the current day first. With all instruments, the days of the same date follow, sampled at the
+// session second of the time spot. The study cache is read and written here, on the engine thread; only the studies
+// it misses and the sampling run in parallel. A non-empty time string also asks for the break and drop report of the
+// current day.
+std::vector<HexChartResult> HexChartEngine::draw(quint32 sampleTimeSpot, quint32 numberOfCandlesticks, quint32 timeUnit, qreal tp, qreal sl, const QString& timeString, bool allInstruments)
+{
+	if (allInstruments)
+		HexChartEngine::findCompanions();
+	
+	const auto synchronized = (allInstruments and HexChartEngine::currentDay->size() > 0u);
+	std::vector<HexChartResult> results(synchronized ? 1u + HexChartEngine::companionDays.size() : 1u);
+	std::vector<bool> missed(results.size(), false);
+	std::vector<QByteArray> keys(results.size());
+	
+	const auto dayOf = [this](quint32 k) -> const std::shared_ptr<HexDayAnalysis>& { return (k == 0u ? HexChartEngine::currentDay : HexChartEngine::companionDays[k - 1u]); };
+	const auto pathOf = [this](quint32 k) -> const QString& { return (k == 0u ? HexChartEngine::currentPath : HexChartEngine::companionPaths[k - 1u]); };
+	
+	// A day file is only hashed when its recent studies miss, and once for both the restore and the save.
+	for (auto k = 0u; k < results.size(); ++k)
+	{
+		if (pathOf(k).isEmpty() or dayOf(k)->isStudied(tp, sl) or dayOf(k)->recall(tp, sl))
+			continue;
+		
+		keys[k] = HexStudyCache::Key(pathOf(k));
+		missed[k] = !HexChartEngine::studyCache.restore(keys[k], tp, sl, *dayOf(k));
+	}
+	
+	const auto drawPane = [&](quint32 k)
+	{
+		const auto& day = dayOf(k);
+		const auto position = (k == 0u ? sampleTimeSpot : day->indexAtSecond(HexChartEngine::currentDay->secondOf(sampleTimeSpot)));
+		
+		if (missed[k])
+			day->study(tp, sl);
+		
+		results[k].strips = day->extractSample(position, numberOfCandlesticks, timeUnit, tp, sl);
+		results[k].title = QFileInfo(pathOf(k)).completeBaseName();
+		results[k].timeSpot = position;
+		results[k].endSecond = HexChartEngine::EndSecond(*day, results[k].strips, timeUnit);
+		results[k].dayLength = day->size();
+		results[k].completed = true;
+	};
+	
+	if (results.size() == 1u)
+		drawPane(0u);
+	else
+	{
+		std::vector<quint32> panes(results.size());
+		std::iota(panes.begin(), panes.end(), 0u);
+		QtConcurrent::blockingMap(panes, drawPane);
+	}
+	
+	for (auto k = 0u; k < results.size(); ++k)
+		if (missed[k])
+			HexChartEngine::studyCache.save(keys[k], tp, sl, *dayOf(k));
+	
+	if (!timeString.isEmpty())
+		results.front().report = QString::fromStdString(HexChartEngine::currentDay->sumUpBreaksAndDrops(timeString.toStdString()));
+	
+	return results;
+}
+
+// The last strip ends a time unit after its time spot, or with the day.
+quint32 HexChartEngine::EndSecond(const HexDayAnalysis& day, const std::vector<HexStrip>& strips, quint32 timeUnit)
+{
+	if (strips.empty())
+		return 0u;
+	
+	return day.secondOf(std::min(strips.back().timeSpot + timeUnit, day.size()));
+}
+
+// The days of the other instruments with the date of the current one, decoded in parallel when not in memory. They
+// are looked up once per current day.
+void HexChartEngine::findCompanions(void)
+{
+	if (HexChartEngine::companionsOf == HexChartEngine::currentDay)
+		return;
+	
+	HexChartEngine::companionsOf = HexChartEngine::currentDay;
+	HexChartEngine::companionDays.clear();
+	HexChartEngine::companionPaths.clear();
+	
+	if (HexChartEngine::archiveIndex < 0)
+		return;
+	
+	const auto indices = HexChartEngine::archive.sameDate(static_cast<quint32>(HexChartEngine::archiveIndex));
+	const auto days = HexChartEngine::archive.days(indices);
+	
+	for (auto i = 0u; i < indices.size(); ++i)
+	{
+		if (days[i] == nullptr)
+			continue;
+		
+		HexChartEngine::companionDays.push_back(days[i]);
+		HexChartEngine::companionPaths.push_back(HexChartEngine::archive.entry(indices[i]).filePath);
+	}
+}
+
+// The archive is only rescanned when its root changes, or when the file is not in it yet.
+HexLoadResult HexChartEngine::load(const QString& filePath)
+{
+	HEX_PROFILE_SCOPE("HexChartEngine::load");
+	HexLoadResult result;
+	result.filePath = filePath;
+	
+	std::shared_ptr<HexDayAnalysis> analysis;
+	result.report = HexDayArchive::LoadDay(filePath, analysis);
+	
+	if (analysis == nullptr)
+		return result;
+	
+	if (HexChartEngine::archive.open(QFileInfo(filePath).dir().absolutePath() + "/.."))
+		HexChartEngine::archive.refresh();
+	
+	HexChartEngine::archiveIndex = HexChartEngine::archive.find(filePath);
+	
+	if (HexChartEngine::archiveIndex < 0 and HexChartEngine::archive.refresh())
+		HexChartEngine::archiveIndex = HexChartEngine::archive.find(filePath);
+	
+	if (HexChartEngine::archiveIndex >= 0)
+		HexChartEngine::archive.insert(static_cast<quint32>(HexChartEngine::archiveIndex), analysis);
+	
+	HexChartEngine::currentDay = analysis;
+	HexChartEngine::currentPath = filePath;
+	result.loaded = true;
+	return result;
+}
+
+HexLoadResult HexChartEngine::startLive(const HexColumns& extrema, const QString& source)
+{
+	HexLoadResult result;
+	result.filePath = source;
+	
+	const auto& [dMin, wMin, mMin, yMin] = extrema.minima;
+	const auto& [dMax, wMax, mMax, yMax] = extrema.maxima;
+	
+	HexChartEngine::liveDay = std::make_shared<HexDayAnalysis>();
+	HexChartEngine::liveDay->setMinima(dMin, wMin, mMin, yMin);
+	HexChartEngine::liveDay->setMaxima(dMax, wMax, mMax, yMax);
+	
+	HexChartEngine::archiveIndex = -1;
+	HexChartEngine::currentDay = HexChartEngine::liveDay;
+	HexChartEngine::currentPath.clear();
+	result.report.error = HexParseReport::None;
+	result.loaded = true;
+	return result;
+}
+
+// A day without neighbour in that direction leaves the file path of the result empty.
+HexLoadResult HexChartEngine::switchDay(qint32 step)
+{
+	HexLoadResult result;
+	
+	if (HexChartEngine::archiveIndex < 0)
+		return result;
+	
+	const auto index = HexChartEngine::archive.neighbour(static_cast<quint32>(HexChartEngine::archiveIndex), step);
+	
+	if (index < 0)
+		return result;
+	
+	const auto analysis = HexChartEngine::archive.day(static_cast<quint32>(index), result.report);
+	result.filePath = HexChartEngine::archive.entry(static_cast<quint32>(index)).filePath;
+	
+	if (analysis == nullptr)
+		return result;
+	
+	HexChartEngine::archiveIndex = index;
+	HexChartEngine::currentDay = analysis;
+	HexChartEngine::currentPath = result.filePath;
+	result.loaded = true;
+	return result;
+}
+
+// The strips of whole tiles of the current day, tile k starting at strip k times the strips per tile. Tiles past the
+// end of the day come back empty.
+std::vector<std::vector<HexStrip>> HexChartEngine::tiles(const std::vector<quint32>& indices, quint32 stripsPerTile, quint32 timeUnit, qreal tp, qreal sl)
+{
+	if (!HexChartEngine::currentDay->isStudied(tp, sl))
+	{
+		if (HexChartEngine::currentPath.isEmpty())
+			HexChartEngine::currentDay->study(tp, sl);
+		else
+			HexChartEngine::studyCache.study(HexChartEngine::currentPath, tp, sl, *HexChartEngine::currentDay);
+	}
+	
+	const auto size = static_cast<quint64>(HexChartEngine::currentDay->size());
+	std::vector<std::vector<HexStrip>> result(indices.size());
+	
+	for (auto i = 0u; i < indices.size(); ++i)
+	{
+		const auto start = static_cast<quint64>(indices[i])*stripsPerTile*timeUnit;
+		
+		if (start >= size)
+			continue;
+		
+		const auto numberOfStrips = std::min<quint64>(stripsPerTile, (size - start + timeUnit - 1u)/timeUnit);
+		result[i] = HexChartEngine::currentDay->extractCandlestickData(static_cast<quint32>(start), static_cast<quint32>(numberOfStrips), timeUnit);
+	}
+	
+	return result;
+}
+
+#endif
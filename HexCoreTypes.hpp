@@ -0,0 +1,442 @@
+#ifndef __HEX_CORE_TYPES_HPP__
+#define __HEX_CORE_TYPES_HPP__
+
+// Standard Libraries
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+// Plain data shared by the analysis core and everything built on it. Nothing here depends on Qt, so the core
+// headers that only include this one can be used from headless tools without linking any Qt module.
+
+// The candlesticks of a day as one array per field. Passes that only need prices (classification, table builds)
+// stream the two price columns instead of a padded 32-byte struct per candlestick.
+struct HexCandlesticks
+{
+	std::vector<double>		lows;
+	std::vector<double>		highs;
+	std::vector<double>		levelsToBuyOrSell;
+	std::vector<char>		winningOrders;
+	std::vector<char>		breaksOrDrops;
+	
+	inline void append(double low, double high)
+	{
+		lows.push_back(low);
+		highs.push_back(high);
+		levelsToBuyOrSell.push_back(0.);
+		winningOrders.push_back('u');
+		breaksOrDrops.push_back('_');
+	}
+	
+	inline void clear(void)
+	{
+		lows.clear();
+		highs.clear();
+		levelsToBuyOrSell.clear();
+		winningOrders.clear();
+		breaksOrDrops.clear();
+	}
+	
+	inline void reserve(std::size_t count)
+	{
+		lows.reserve(count);
+		highs.reserve(count);
+		levelsToBuyOrSell.reserve(count);
+		winningOrders.reserve(count);
+		breaksOrDrops.reserve(count);
+	}
+	
+	inline std::size_t size(void) const
+	{
+		return lows.size();
+	}
+};
+
+// Extrema, last break or drop and outcome counts (b, s, u, B, S) of a run of candlesticks, as drawn in one strip.
+struct HexAggregate
+{
+	std::array<std::uint32_t, 5u>	outcomes = { };
+	double				low = std::numeric_limits<double>::max();
+	double				high = -std::numeric_limits<double>::max();
+	char				breakOrDrop = '_';
+	
+	inline static std::uint32_t Slot(char winningOrder)
+	{
+		switch (winningOrder)
+		{
+			case 'b':
+				return 0u;
+			
+			case 's':
+				return 1u;
+			
+			case 'u':
+				return 2u;
+			
+			case 'B':
+				return 3u;
+			
+			case 'S':
+				return 4u;
+		}
+		
+		return 5u;
+	}
+	
+	inline void add(const HexCandlesticks& cs, std::uint32_t index)
+	{
+		low = std::min(low, cs.lows[index]);
+		high = std::max(high, cs.highs[index]);
+		
+		if (cs.breaksOrDrops[index] != '_')
+			breakOrDrop = cs.breaksOrDrops[index];
+		
+		const auto slot = Slot(cs.winningOrders[index]);
+		
+		if (slot < 5u)
+			++outcomes[slot];
+	}
+	
+	// Moves one candlestick from the count of an outcome to the count of another.
+	inline void recount(char from, char to)
+	{
+		const auto oldSlot = Slot(from);
+		const auto newSlot = Slot(to);
+		
+		if (oldSlot < 5u)
+			--outcomes[oldSlot];
+		
+		if (newSlot < 5u)
+			++outcomes[newSlot];
+	}
+	
+	inline HexAggregate& operator+=(const HexAggregate& other)
+	{
+		low = std::min(low, other.low);
+		high = std::max(high, other.high);
+		
+		if (other.breakOrDrop != '_')
+			breakOrDrop = other.breakOrDrop;
+		
+		for (auto i = 0u; i < 5u; ++i)
+			outcomes[i] += other.outcomes[i];
+		
+		return *this;
+	}
+};
+
+// A day file as plain price columns, for tools that do not need a full analysis.
+struct HexColumns
+{
+	std::array<double, 4u>		minima = { };
+	std::array<double, 4u>		maxima = { };
+	std::vector<double>		lows;
+	std::vector<double>		highs;
+	
+	inline void clear(void)
+	{
+		lows.clear();
+		highs.clear();
+	}
+	
+	inline void saveCandlestick(double low, double high)
+	{
+		lows.push_back(low);
+		highs.push_back(high);
+	}
+	
+	inline void saveCandlesticks(const std::int32_t* lowTicks, const std::int32_t* highTicks, std::uint32_t count)
+	{
+		for (auto i = 0u; i < count; ++i)
+			saveCandlestick(lowTicks[i]*0.25, highTicks[i]*0.25);
+	}
+	
+	inline void setMaxima(double d, double w, double m, double y)
+	{
+		maxima = { d, w, m, y };
+	}
+	
+	inline void setMinima(double d, double w, double m, double y)
+	{
+		minima = { d, w, m, y };
+	}
+};
+
+struct HexInfoFile
+{
+	double		min = std::numeric_limits<double>::max();
+	double		rawMin = std::numeric_limits<double>::max();
+	
+	double		max = -std::numeric_limits<double>::max();
+	double		rawMax = -std::numeric_limits<double>::max();
+};
+
+// Latencies in microseconds, summed up by nearest-rank percentiles.
+struct HexLatencySamples
+{
+	std::vector<double>		microseconds;
+	
+	inline void add(double value)
+	{
+		microseconds.push_back(value);
+	}
+	
+	inline double percentile(double fraction) const
+	{
+		if (microseconds.empty())
+			return 0.;
+		
+		auto sorted = microseconds;
+		const auto rank = static_cast<std::size_t>(std::ceil(fraction*static_cast<double>(sorted.size())));
+		const auto nth = sorted.begin() + static_cast<std::ptrdiff_t>(std::clamp<std::size_t>(rank, 1u, sorted.size()) - 1u);
+		std::nth_element(sorted.begin(), nth, sorted.end());
+		return *nth;
+	}
+};
+
+// Counts of the outcome letters (b, s, u, B, S, e) of the breaks and drops of a level. The four classes of the reports
+// follow from them: Buy (B), Sell (S), either (b, s, e) and uncertainty (u).
+struct HexLevelTally
+{
+	std::array<std::uint32_t, 6u>	letters = { };
+	
+	inline static std::uint32_t Letter(char winningOrder)
+	{
+		switch (winningOrder)
+		{
+			case 'b':
+				return 0u;
+			
+			case 's':
+				return 1u;
+			
+			case 'u':
+				return 2u;
+			
+			case 'B':
+				return 3u;
+			
+			case 'S':
+				return 4u;
+			
+			case 'e':
+				return 5u;
+		}
+		
+		return 6u;
+	}
+	
+	inline void add(char winningOrder)
+	{
+		const auto letter = Letter(winningOrder);
+		
+		if (letter < 6u)
+			++letters[letter];
+	}
+	
+	inline double buyExpectation(double tp, double sl) const
+	{
+		return tp*(ratio(0u) + ratio(2u))/100. - sl*ratio(1u)/100.;
+	}
+	
+	inline double buyProfit(double tp, double sl) const
+	{
+		return tp*(outcome(0u) + outcome(2u)) - sl*outcome(1u);
+	}
+	
+	inline std::uint32_t occurrences(void) const
+	{
+		return letters[0u] + letters[1u] + letters[2u] + letters[3u] + letters[4u] + letters[5u];
+	}
+	
+	// Buy (0), Sell (1), either (2) or uncertainty (3).
+	inline std::uint32_t outcome(std::uint32_t index) const
+	{
+		switch (index)
+		{
+			case 0u:
+				return letters[3u];
+			
+			case 1u:
+				return letters[4u];
+			
+			case 2u:
+				return letters[0u] + letters[1u] + letters[5u];
+		}
+		
+		return letters[2u];
+	}
+	
+	inline double ratio(std::uint32_t index) const
+	{
+		return outcome(index)*100./occurrences();
+	}
+	
+	inline double sellExpectation(double tp, double sl) const
+	{
+		return tp*(ratio(1u) + ratio(2u))/100. - sl*ratio(0u)/100.;
+	}
+	
+	inline double sellProfit(double tp, double sl) const
+	{
+		return tp*(outcome(1u) + outcome(2u)) - sl*outcome(0u);
+	}
+	
+	inline HexLevelTally& operator+=(const HexLevelTally& other)
+	{
+		for (auto i = 0u; i < 6u; ++i)
+			letters[i] += other.letters[i];
+		
+		return *this;
+	}
+};
+
+// Sums over the days of a level of their occurrences and buy and sell profits, squared or multiplied, from which the
+// spread of its expectations between days follows. The breaks of one day are not independent of each other, so the
+// days, not the breaks, are the samples of the interval.
+struct HexLevelSpread
+{
+	std::uint32_t			days = 0u;
+	double				occurrenceSquares = 0.;
+	std::array<double, 2u>		profitProducts = { };
+	std::array<double, 2u>		profitSquares = { };
+	
+	inline void add(const HexLevelTally& day, double tp, double sl)
+	{
+		const auto n = static_cast<double>(day.occurrences());
+		
+		if (day.occurrences() == 0u)
+			return;
+		
+		const std::array<double, 2u> profits = { day.buyProfit(tp, sl), day.sellProfit(tp, sl) };
+		++days;
+		occurrenceSquares += n*n;
+		
+		for (auto i = 0u; i < 2u; ++i)
+		{
+			profitProducts[i] += n*profits[i];
+			profitSquares[i] += profits[i]*profits[i];
+		}
+	}
+	
+	// Half the width of the 95% interval of the buy (0) or sell (1) expectation of the total, as the ratio of the
+	// profits to the occurrences clustered by day. NaN below two days with occurrences.
+	inline double margin(const HexLevelTally& total, double tp, double sl, std::uint32_t side) const
+	{
+		if (days < 2u)
+			return std::numeric_limits<double>::quiet_NaN();
+		
+		const auto n = static_cast<double>(total.occurrences());
+		const auto mean = (side == 0u ? total.buyProfit(tp, sl) : total.sellProfit(tp, sl))/n;
+		const auto residuals = profitSquares[side] - 2.*mean*profitProducts[side] + mean*mean*occurrenceSquares;
+		const auto variance = std::max(residuals, 0.)*days/(days - 1.)/(n*n);
+		return 1.96*std::sqrt(variance);
+	}
+	
+	inline HexLevelSpread& operator+=(const HexLevelSpread& other)
+	{
+		days += other.days;
+		occurrenceSquares += other.occurrenceSquares;
+		
+		for (auto i = 0u; i < 2u; ++i)
+		{
+			profitProducts[i] += other.profitProducts[i];
+			profitSquares[i] += other.profitSquares[i];
+		}
+		
+		return *this;
+	}
+};
+
+// The outcomes of every level per half hour of the session and the spread of the level totals between days. Days
+// merge by addition, in any order, so threads reduce their own statistics and add them up at the end.
+struct HexLevelStatistics
+{
+	std::array<std::array<HexLevelTally, 13u>, 8u>	halfHours = { };
+	std::array<HexLevelSpread, 8u>			spreads = { };
+	
+	inline HexLevelStatistics& operator+=(const HexLevelStatistics& other)
+	{
+		for (auto l = 0u; l < 8u; ++l)
+		{
+			for (auto h = 0u; h < 13u; ++h)
+				halfHours[l][h] += other.halfHours[l][h];
+			
+			spreads[l] += other.spreads[l];
+		}
+		
+		return *this;
+	}
+};
+
+// The buy and sell trades opened on one candlestick while streaming. A side stays open until a later candlestick
+// reaches its target or its stop; its distance is then final, 50'000 standing for a stop or for no crossing yet.
+struct HexOpenTrade
+{
+	std::uint32_t			index;
+	
+	double				buyLower;
+	double				buyUpper;
+	double				sellLower;
+	double				sellUpper;
+	
+	std::uint32_t			buy = 50'000u;
+	std::uint32_t			sell = 50'000u;
+	bool				buyOpen = true;
+	bool				sellOpen = true;
+};
+
+struct HexParseReport
+{
+	enum Error { None, OpenFailure, WrongMinimumData, WrongMaximumData, MalformedLine, InvalidBinaryFile };
+	
+	Error		error = OpenFailure;
+	std::uint32_t	lineCount = 0u;
+};
+
+// One strip of the chart as plain data. The shade summarises the outcomes of its candlesticks and is left for
+// the drawing side to turn into a colour; geometry follows from the strip index and the extrema.
+struct HexStrip
+{
+	enum Shade { Mixed, BuyCertain, SellCertain, BuyLikely, SellLikely, Undecided };
+	
+	std::string			timestamp;
+	
+	double				low = 0.;
+	double				high = 0.;
+	
+	std::uint32_t			timeSpot;
+	std::uint32_t			second = 0u;
+	char				breakOrDrop = '_';
+	Shade				shade = Mixed;
+	
+	inline HexStrip(const std::string& t, double l, double h, std::uint32_t ts, char b) : timestamp(t), low(l), high(h), timeSpot(ts), breakOrDrop(b)
+	{
+	}
+};
+
+// The outcomes of one study, kept so that switching back to its TP and SL only copies them.
+struct HexStudyMemo
+{
+	double				takeProfit;
+	double				stopLoss;
+	std::vector<char>		winningOrders;
+};
+
+struct HexSweepCell
+{
+	double					takeProfit;
+	double					stopLoss;
+	std::array<HexLevelTally, 8u>		levels = { };
+	
+	inline HexSweepCell(double tp, double sl) : takeProfit(tp), stopLoss(sl)
+	{
+	}
+};
+
+#endif
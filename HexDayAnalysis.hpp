@@ -4,45 +4,106 @@
 // Standard Libraries
 #include <algorithm>
 #include <array>
+#include <charconv>
+#include <cstdlib>
 #include <limits>
+#include <string>
 #include <vector>
 
 // Personal Libraries
-#include "OtherClasses.hpp"
+#include "HexAggregationPyramid.hpp"
+#include "HexEventIndex.hpp"
+#include "HexExtremumTable.hpp"
+#include "HexForwardScan.hpp"
+#include "HexCoreTypes.hpp"
+#include "HexProfiler.hpp"
 
 class HexDayAnalysis
 {
 	private:
 		
-		std::vector<HexCandlestick>		candlesticks;
+		static constexpr std::uint32_t		RecentStudies = 4u;
+		static constexpr std::array<char, 9u>	BreakCodes = { '_', 'D', 'W', 'M', 'Y', 'd', 'w', 'm', 'y' };
+		static constexpr std::array<char, 6u>	OutcomeCodes = { 'b', 's', 'u', 'B', 'S', 'e' };
+		
+		inline static std::string		FixedPoint(double);
+		inline static std::uint32_t		LevelIndex(char);
+		inline static std::uint32_t		OutcomeIndex(char);
+		inline static char			Verdict(std::uint32_t, std::uint32_t);
+		
+		HexCandlesticks				candlesticks;
+		std::vector<std::uint32_t>		breaksAndDrops;
+		std::vector<HexOpenTrade>		openTrades;
+		std::vector<HexStrip>			sampleRing;
+		std::vector<HexStudyMemo>		recentStudies;
+		HexExtremumTable			extremumTable;
+		HexAggregationPyramid			pyramid;
+		HexEventIndex				eventIndex;
 		HexInfoFile				dInfo;
 		HexInfoFile				wInfo;
 		HexInfoFile				mInfo;
 		HexInfoFile				yInfo;
 		
-		qreal					takeProfit = 0.;
-		qreal					stopLoss = 0.;
+		double					takeProfit = 0.;
+		double					stopLoss = 0.;
+		std::uint32_t				sampleHead = 0u;
+		std::uint32_t				sampleStart = 0u;
+		std::uint32_t				sampleUnit = 0u;
+		std::uint32_t				sampleDirtyFrom = std::numeric_limits<std::uint32_t>::max();
+		bool					classificationNotCompleted = true;
+		bool					eventsNotIndexed = true;
+		bool					live = false;
+		bool					sampleNotReusable = true;
 		bool					studyNotCompleted = true;
+		bool					tradesNotTracked = true;
 		
-		inline void				appendCouple(QString&, quint32&, quint32) const;
-		inline std::vector<HexStrip>		extractCandlestickData(quint32, quint32, quint32) const;
-		inline QString				record(const QString&, const QString&, const std::array<std::vector<quint32>, 4u>&) const;
-		inline void				study(qreal, qreal);
-		inline void				update(HexCandlestick&);
-		inline quint32				strictBuyAndSell(std::vector<HexCandlestick>::const_iterator, qreal, qreal) const;
-		inline quint32				strictSellAndBuy(std::vector<HexCandlestick>::const_iterator, qreal, qreal) const;
-		inline QString				timeString(quint32) const;
+		inline void				appendCouple(std::string&, std::uint32_t&, const HexEvent&) const;
+		inline void				classify(void);
+		inline void				finishStudy(void);
+		inline void				indexEvents(void);
+		inline std::uint32_t			liveRing(std::uint32_t, std::uint32_t, double, double);
+		inline HexOpenTrade			openTrade(std::uint32_t) const;
+		inline char				outcome(std::uint32_t, double, double) const;
+		inline void				prepare(void);
+		inline std::string			record(const std::string&, const std::string&, std::uint32_t) const;
+		inline void				remember(void);
+		inline void				resolveOpenTrades(std::uint32_t);
+		inline std::vector<HexStrip>		ringStrips(std::uint32_t) const;
+		inline std::uint32_t			slideRing(std::uint32_t, std::uint32_t, std::uint32_t);
+		inline std::vector<HexStrip>		slideSample(std::uint32_t, std::uint32_t, std::uint32_t);
+		inline void				update(std::uint32_t);
+		inline std::uint32_t			strictBuyAndSell(std::uint32_t, double, double) const;
+		inline std::uint32_t			strictSellAndBuy(std::uint32_t, double, double) const;
+		inline std::string			timeString(std::uint32_t) const;
+		inline void				trackOpenTrades(void);
 	
 	public:
 	
+		static constexpr std::uint32_t		ScanWindow = 64u;
+		
 		inline					HexDayAnalysis(void);
 		
+		inline void				appendCandlestick(double, double);
 		inline void				clear(void);
-		inline std::vector<HexStrip>		extractSample(quint32, quint32, quint32, qreal, qreal);
-		inline void				saveCandlestick(qreal, qreal);
-		inline void				setMaxima(qreal, qreal, qreal, qreal);
-		inline void				setMinima(qreal, qreal, qreal, qreal);
-		inline QString				sumUpBreaksAndDrops(const QString&) const;
+		inline const HexEventIndex&		events(void) const;
+		inline std::vector<HexStrip>		extractCandlestickData(std::uint32_t, std::uint32_t, std::uint32_t) const;
+		inline std::vector<HexStrip>		extractLiveChanges(std::uint32_t, std::uint32_t, double, double, std::uint32_t&);
+		inline std::vector<HexStrip>		extractLiveSample(std::uint32_t, std::uint32_t, double, double);
+		inline std::vector<HexStrip>		extractSample(std::uint32_t, std::uint32_t, std::uint32_t, double, double);
+		inline std::uint32_t			indexAtSecond(std::uint32_t) const;
+		inline bool				isStudied(double, double) const;
+		inline bool				recall(double, double);
+		inline bool				restoreStudy(double, double, const std::uint8_t*, std::uint32_t);
+		inline void				saveCandlestick(double, double);
+		inline void				saveCandlesticks(const std::int32_t*, const std::int32_t*, std::uint32_t);
+		inline std::uint32_t			secondOf(std::uint32_t) const;
+		inline void				setMaxima(double, double, double, double);
+		inline void				setMinima(double, double, double, double);
+		inline std::uint32_t			size(void) const;
+		inline void				study(double, double);
+		inline std::vector<std::uint8_t>	studyCodes(void) const;
+		inline std::string			sumUpBreaksAndDrops(const std::string&) const;
+		inline std::array<std::array<HexLevelTally, 13u>, 8u>	tallyBreaksAndDrops(double, double);
 };
 
 HexDayAnalysis::HexDayAnalysis(void)
@@ -50,173 +111,498 @@ HexDayAnalysis::HexDayAnalysis(void)
 	HexDayAnalysis::candlesticks.reserve(23'400u);
 }
 
-void HexDayAnalysis::appendCouple(QString& result, quint32& oldCouple, quint32 count) const
+// Streaming entry point: the new candlestick is classified against the running extrema, resolves the open trades
+// it reaches and opens its own, so a studied day stays studied without a pass over the earlier candlesticks.
+void HexDayAnalysis::appendCandlestick(double low, double high)
 {
-	const auto timestamp = count*23'400u/HexDayAnalysis::candlesticks.size();
+	if (HexDayAnalysis::classificationNotCompleted)
+		HexDayAnalysis::classify();
+	
+	if (!HexDayAnalysis::studyNotCompleted and HexDayAnalysis::tradesNotTracked)
+		HexDayAnalysis::trackOpenTrades();
+	
+	const auto index = static_cast<std::uint32_t>(HexDayAnalysis::candlesticks.size());
+	HexDayAnalysis::candlesticks.append(low, high);
+	HexDayAnalysis::update(index);
+	
+	if (HexDayAnalysis::candlesticks.breaksOrDrops[index] != '_')
+	{
+		HexDayAnalysis::breaksAndDrops.push_back(index);
+		HexDayAnalysis::eventsNotIndexed = true;
+	}
+	
+	if (!HexDayAnalysis::live)
+		HexDayAnalysis::eventsNotIndexed = true;
+	
+	HexDayAnalysis::live = true;
+	HexDayAnalysis::sampleDirtyFrom = std::min(HexDayAnalysis::sampleDirtyFrom, index);
+	HexDayAnalysis::recentStudies.clear();
+	
+	if (HexDayAnalysis::studyNotCompleted)
+		return;
+	
+	HexDayAnalysis::resolveOpenTrades(index);
+	HexDayAnalysis::openTrades.push_back(HexDayAnalysis::openTrade(index));
+	HexDayAnalysis::pyramid.extend(HexDayAnalysis::candlesticks);
+	
+	if (HexDayAnalysis::eventsNotIndexed)
+		HexDayAnalysis::indexEvents();
+}
+
+void HexDayAnalysis::appendCouple(std::string& result, std::uint32_t& oldCouple, const HexEvent& event) const
+{
+	const auto timestamp = event.second;
 	const auto hour = 15u + (timestamp + 1'800u)/3'600u;
 	const auto minute = (30u + timestamp/60u) % 60u;
 	const auto newCouple = 100u*hour + minute;
 	
 	if (newCouple != oldCouple)
 	{
-		const QString zeroPadding = (minute < 10u ? "0" : "");
-		result += " <a href=" + QString::number(count) + ">[" + QString::number(hour) + ':' + zeroPadding + QString::number(minute) + "]</a>";
+		const std::string zeroPadding = (minute < 10u ? "0" : "");
+		result += " <a href=" + std::to_string(event.index) + ">[" + std::to_string(hour) + ':' + zeroPadding + std::to_string(minute) + "]</a>";
 		oldCouple = newCouple;
 	}
 }
 
+void HexDayAnalysis::classify(void)
+{
+	HexDayAnalysis::dInfo.min = HexDayAnalysis::dInfo.rawMin;
+	HexDayAnalysis::wInfo.min = HexDayAnalysis::wInfo.rawMin;
+	HexDayAnalysis::mInfo.min = HexDayAnalysis::mInfo.rawMin;
+	HexDayAnalysis::yInfo.min = HexDayAnalysis::yInfo.rawMin;
+	
+	HexDayAnalysis::dInfo.max = HexDayAnalysis::dInfo.rawMax;
+	HexDayAnalysis::wInfo.max = HexDayAnalysis::wInfo.rawMax;
+	HexDayAnalysis::mInfo.max = HexDayAnalysis::mInfo.rawMax;
+	HexDayAnalysis::yInfo.max = HexDayAnalysis::yInfo.rawMax;
+	
+	HexDayAnalysis::breaksAndDrops.clear();
+	HexDayAnalysis::recentStudies.clear();
+	HexDayAnalysis::eventIndex.clear();
+	HexDayAnalysis::eventsNotIndexed = true;
+	
+	for (auto i = 0u; i < HexDayAnalysis::candlesticks.size(); ++i)
+	{
+		HexDayAnalysis::update(i);
+		
+		if (HexDayAnalysis::candlesticks.breaksOrDrops[i] != '_')
+			HexDayAnalysis::breaksAndDrops.push_back(i);
+	}
+	
+	HexDayAnalysis::classificationNotCompleted = false;
+}
+
 void HexDayAnalysis::clear(void)
 {
 	HexDayAnalysis::candlesticks.clear();
+	HexDayAnalysis::breaksAndDrops.clear();
+	HexDayAnalysis::openTrades.clear();
+	HexDayAnalysis::sampleRing.clear();
+	HexDayAnalysis::extremumTable.clear();
+	HexDayAnalysis::pyramid.clear();
+	HexDayAnalysis::eventIndex.clear();
+	HexDayAnalysis::classificationNotCompleted = true;
+	HexDayAnalysis::eventsNotIndexed = true;
+	HexDayAnalysis::live = false;
+	HexDayAnalysis::sampleNotReusable = true;
 	HexDayAnalysis::studyNotCompleted = true;
+	HexDayAnalysis::tradesNotTracked = true;
 }
 
-std::vector<HexStrip> HexDayAnalysis::extractCandlestickData(quint32 start, quint32 numberOfCandlesticks, quint32 secondsPerCandlestick) const
+std::vector<HexStrip> HexDayAnalysis::extractCandlestickData(std::uint32_t start, std::uint32_t numberOfCandlesticks, std::uint32_t secondsPerCandlestick) const
 {
+	HEX_PROFILE_SCOPE("HexDayAnalysis::extractCandlestickData");
 	std::vector<HexStrip> foo;
 	foo.reserve(numberOfCandlesticks);
 	
-	auto it = HexDayAnalysis::candlesticks.cbegin() + start;
+	const auto size = static_cast<std::uint32_t>(HexDayAnalysis::candlesticks.size());
 	
 	for (auto i = 0u; i < numberOfCandlesticks; ++i)
 	{
-		auto max = -std::numeric_limits<qreal>::max();
-		auto min = std::numeric_limits<qreal>::max();
-		
-		auto breakOrDrop = '_';
-		auto bCount = 0u;
-		auto sCount = 0u;
-		auto uCount = 0u;
-		auto BCount = 0u;
-		auto SCount = 0u;
-		
-		for (auto j = 0u; j < secondsPerCandlestick; ++j)
-		{
-			if (it->low < min)
-				min = it->low;
-			
-			if (it->high > max)
-				max = it->high;
-			
-			if (it->breakOrDrop != '_' and it->breakOrDrop != breakOrDrop)
-				breakOrDrop = it->breakOrDrop;
-			
-			switch (it->winningOrder)
-			{
-				case 'b':
-					++bCount;
-					break;
-				
-				case 's':
-					++sCount;
-					break;
-				
-				case 'u':
-					++uCount;
-					break;
-				
-				case 'B':
-					++BCount;
-					break;
-				
-				case 'S':
-					++SCount;
-					break;
-			}
-			
-			++it;
-		}
-		
-		const auto rect = QRectF(static_cast<qreal>(i) + 0.1f, -max, 0.8f, max - min);
 		const auto timeSpot = start + i*secondsPerCandlestick;
+		const auto aggregate = HexDayAnalysis::pyramid.aggregate(HexDayAnalysis::candlesticks, timeSpot, std::min(secondsPerCandlestick, size - timeSpot));
+		const auto [bCount, sCount, uCount, BCount, SCount] = aggregate.outcomes;
 		
-		foo.emplace_back(HexDayAnalysis::timeString(timeSpot), rect, min, max, timeSpot, breakOrDrop);
+		foo.emplace_back(HexDayAnalysis::timeString(timeSpot), aggregate.low, aggregate.high, timeSpot, aggregate.breakOrDrop);
+		foo.back().second = HexDayAnalysis::secondOf(timeSpot);
 		
-		if (uCount != 0u)
-			foo.back().brush = QBrush(QColor(153, 153, 153));
+		if (uCount != 0u or (BCount != 0u and SCount != 0u))
+			foo.back().shade = HexStrip::Mixed;
 		else if (BCount != 0u)
-			foo.back().brush = (SCount != 0u ? QBrush(QColor(153, 153, 153)) : QBrush(QColor(102, 153, 255)));
+			foo.back().shade = HexStrip::BuyCertain;
 		else if (SCount != 0u)
-			foo.back().brush = QBrush(QColor(255, 102, 102));
+			foo.back().shade = HexStrip::SellCertain;
 		else if (sCount == 0u)
-			foo.back().brush = (bCount != 0u ? QBrush(QColor(102, 153, 255), Qt::Dense4Pattern) : QBrush(QColor(153, 153, 255), Qt::Dense4Pattern));
+			foo.back().shade = (bCount != 0u ? HexStrip::BuyLikely : HexStrip::Undecided);
 		else if (bCount == 0u)
-			foo.back().brush = QBrush(QColor(255, 102, 102), Qt::Dense4Pattern);
+			foo.back().shade = HexStrip::SellLikely;
 		else
-			foo.back().brush = QBrush(QColor(153, 153, 255), Qt::Dense4Pattern);
+			foo.back().shade = HexStrip::Undecided;
 	}
 	
 	return foo;
 }
 
-std::vector<HexStrip> HexDayAnalysis::extractSample(quint32 positionInData, quint32 numberOfCandlesticks, quint32 timeUnit, qreal tp, qreal sl)
+// The strips of the live sample from the first one that changed since the previous call, which is 0 when the whole
+// window moved and the number of strips when nothing changed.
+std::vector<HexStrip> HexDayAnalysis::extractLiveChanges(std::uint32_t numberOfCandlesticks, std::uint32_t timeUnit, double tp, double sl, std::uint32_t& firstStrip)
+{
+	firstStrip = HexDayAnalysis::liveRing(numberOfCandlesticks, timeUnit, tp, sl);
+	return HexDayAnalysis::ringStrips(firstStrip);
+}
+
+std::vector<HexStrip> HexDayAnalysis::extractLiveSample(std::uint32_t numberOfCandlesticks, std::uint32_t timeUnit, double tp, double sl)
+{
+	HexDayAnalysis::liveRing(numberOfCandlesticks, timeUnit, tp, sl);
+	return HexDayAnalysis::ringStrips(0u);
+}
+
+std::vector<HexStrip> HexDayAnalysis::extractSample(std::uint32_t positionInData, std::uint32_t numberOfCandlesticks, std::uint32_t timeUnit, double tp, double sl)
 {
-	if (HexDayAnalysis::studyNotCompleted or HexDayAnalysis::takeProfit != tp or HexDayAnalysis::stopLoss != sl)
-		HexDayAnalysis::study(tp, sl);
-	
 	const auto size = HexDayAnalysis::candlesticks.size();
 	const auto numberOfElementaryCandlesticks = numberOfCandlesticks*timeUnit;
 	
+	if (numberOfElementaryCandlesticks >= size)
+		return HexDayAnalysis::extractLiveSample(numberOfCandlesticks, timeUnit, tp, sl);
+	
+	if (!HexDayAnalysis::isStudied(tp, sl))
+		HexDayAnalysis::study(tp, sl);
+	
 	if (positionInData < numberOfElementaryCandlesticks/5u)
-		return HexDayAnalysis::extractCandlestickData(0u, numberOfCandlesticks, timeUnit);
+		return HexDayAnalysis::slideSample(0u, numberOfCandlesticks, timeUnit);
 	
 	if (positionInData - numberOfElementaryCandlesticks/5u + numberOfElementaryCandlesticks >= size)
-		return HexDayAnalysis::extractCandlestickData(size - numberOfElementaryCandlesticks, numberOfCandlesticks, timeUnit);
+		return HexDayAnalysis::slideSample(size - numberOfElementaryCandlesticks, numberOfCandlesticks, timeUnit);
 	
-	return HexDayAnalysis::extractCandlestickData(positionInData - numberOfElementaryCandlesticks/5u, numberOfCandlesticks, timeUnit);
+	return HexDayAnalysis::slideSample(positionInData - numberOfElementaryCandlesticks/5u, numberOfCandlesticks, timeUnit);
 }
 
-QString HexDayAnalysis::record(const QString& time, const QString& str, const std::array<std::vector<quint32>, 4u>& info) const
+void HexDayAnalysis::finishStudy(void)
 {
-	const auto sum = info[0u].size() + info[1u].size() + info[2u].size() + info[3u].size();
+	HexDayAnalysis::pyramid.build(HexDayAnalysis::candlesticks);
+	HexDayAnalysis::indexEvents();
+	HexDayAnalysis::sampleNotReusable = true;
+	HexDayAnalysis::studyNotCompleted = false;
+	HexDayAnalysis::tradesNotTracked = true;
+}
+
+const HexEventIndex& HexDayAnalysis::events(void) const
+{
+	return HexDayAnalysis::eventIndex;
+}
+
+// Two decimals, as printed in the break and drop report.
+std::string HexDayAnalysis::FixedPoint(double value)
+{
+	char buffer[32];
+	const auto end = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::fixed, 2).ptr;
+	return std::string(buffer, end);
+}
+
+bool HexDayAnalysis::isStudied(double tp, double sl) const
+{
+	return !HexDayAnalysis::studyNotCompleted and HexDayAnalysis::takeProfit == tp and HexDayAnalysis::stopLoss == sl;
+}
+
+void HexDayAnalysis::indexEvents(void)
+{
+	const auto& cs = HexDayAnalysis::candlesticks;
+	std::vector<HexEvent> events;
+	events.reserve(HexDayAnalysis::breaksAndDrops.size());
+	
+	for (const auto& count : HexDayAnalysis::breaksAndDrops)
+	{
+		const auto level = HexDayAnalysis::LevelIndex(cs.breaksOrDrops[count]);
+		const auto outcome = HexDayAnalysis::OutcomeIndex(cs.winningOrders[count]);
+		events.push_back({ count, HexDayAnalysis::secondOf(count), static_cast<std::uint8_t>(level), static_cast<std::uint8_t>(outcome) });
+	}
+	
+	HexDayAnalysis::eventIndex.build(events);
+	HexDayAnalysis::eventsNotIndexed = false;
+}
+
+// The inverse of secondOf, which lines up days of different instruments on the session clock.
+std::uint32_t HexDayAnalysis::indexAtSecond(std::uint32_t second) const
+{
+	const auto size = static_cast<std::uint32_t>(HexDayAnalysis::candlesticks.size());
+	
+	if (HexDayAnalysis::live)
+		return std::min(second, size);
+	
+	return static_cast<std::uint32_t>(static_cast<std::uint64_t>(second)*size/23'400u);
+}
+
+std::uint32_t HexDayAnalysis::LevelIndex(char breakOrDrop)
+{
+	switch (breakOrDrop)
+	{
+		case 'D':
+			return 0u;
+		
+		case 'W':
+			return 1u;
+		
+		case 'M':
+			return 2u;
+		
+		case 'Y':
+			return 3u;
+		
+		case 'd':
+			return 4u;
+		
+		case 'w':
+			return 5u;
+		
+		case 'm':
+			return 6u;
+	}
+	
+	return 7u;
+}
+
+// Moves the sample to the newest candlestick and returns the first strip that changed. Strips are aligned on the time
+// unit, so the last one fills up as candlesticks arrive and only the strips touched since the previous call are
+// aggregated again.
+std::uint32_t HexDayAnalysis::liveRing(std::uint32_t numberOfCandlesticks, std::uint32_t timeUnit, double tp, double sl)
+{
+	if (!HexDayAnalysis::isStudied(tp, sl))
+		HexDayAnalysis::study(tp, sl);
+	
+	const auto size = static_cast<std::uint32_t>(HexDayAnalysis::candlesticks.size());
+	
+	if (size == 0u)
+	{
+		HexDayAnalysis::sampleRing.clear();
+		HexDayAnalysis::sampleNotReusable = true;
+		return 0u;
+	}
+	
+	const auto last = (size - 1u)/timeUnit;
+	const auto first = (last + 1u > numberOfCandlesticks ? last + 1u - numberOfCandlesticks : 0u);
+	return HexDayAnalysis::slideRing(first*timeUnit, last + 1u - first, timeUnit);
+}
+
+HexOpenTrade HexDayAnalysis::openTrade(std::uint32_t index) const
+{
+	const auto& cs = HexDayAnalysis::candlesticks;
+	const auto flagged = (cs.breaksOrDrops[index] != '_');
+	const auto buyPrice = (flagged ? cs.levelsToBuyOrSell[index] : cs.highs[index]);
+	const auto sellPrice = (flagged ? cs.levelsToBuyOrSell[index] : cs.lows[index]);
+	
+	HexOpenTrade trade;
+	trade.index = index;
+	trade.buyLower = buyPrice - HexDayAnalysis::stopLoss;
+	trade.buyUpper = buyPrice + HexDayAnalysis::takeProfit;
+	trade.sellLower = sellPrice - HexDayAnalysis::takeProfit;
+	trade.sellUpper = sellPrice + HexDayAnalysis::stopLoss;
+	return trade;
+}
+
+char HexDayAnalysis::outcome(std::uint32_t index, double tp, double sl) const
+{
+	const auto& cs = HexDayAnalysis::candlesticks;
+	const auto flagged = (cs.breaksOrDrops[index] != '_');
+	
+	const auto buyPrice = (flagged ? cs.levelsToBuyOrSell[index] : cs.highs[index]);
+	const auto buy = HexDayAnalysis::strictBuyAndSell(index + 1u, buyPrice - sl, buyPrice + tp);
+	
+	const auto sellPrice = (flagged ? cs.levelsToBuyOrSell[index] : cs.lows[index]);
+	const auto sell = HexDayAnalysis::strictSellAndBuy(index + 1u, sellPrice - tp, sellPrice + sl);
+	return HexDayAnalysis::Verdict(buy, sell);
+}
+
+std::uint32_t HexDayAnalysis::OutcomeIndex(char winningOrder)
+{
+	switch (winningOrder)
+	{
+		case 'B':
+			return 0u;
+		
+		case 'S':
+			return 1u;
+		
+		case 'b':
+		case 'e':
+		case 's':
+			return 2u;
+	}
+	
+	return 3u;
+}
+
+// Brings the classification and the tables up to date with the candlesticks before outcomes are computed.
+void HexDayAnalysis::prepare(void)
+{
+	if (HexDayAnalysis::classificationNotCompleted)
+		HexDayAnalysis::classify();
+	
+	if (HexDayAnalysis::extremumTable.numberOfCandlesticks() != HexDayAnalysis::candlesticks.size())
+		HexDayAnalysis::extremumTable.build(HexDayAnalysis::candlesticks.lows, HexDayAnalysis::candlesticks.highs);
+}
+
+std::string HexDayAnalysis::record(const std::string& time, const std::string& str, std::uint32_t level) const
+{
+	static const std::array<std::string, 4u> sides = { "Buy", "Sell", "Either", "Uncertainty" };
+	
+	HexLevelTally tally;
+	
+	for (auto i = 0u; i < HexEventIndex::Outcomes; ++i)
+		for (const auto& event : HexDayAnalysis::eventIndex.bucket(level, i))
+			tally.add(HexDayAnalysis::candlesticks.winningOrders[event.index]);
+	
+	const auto sum = tally.occurrences();
 	
 	if (sum == 0u)
 		return "";
 	
-	QString letterS = (sum > 1u ? "s" : "");
-	QString result = "<p.small>" + time + ' ' + str + ' ' + QString::number(sum) + " occurrence" + letterS + ".</p>";
+	std::string letterS = (sum > 1u ? "s" : "");
+	std::string result = "<p.small>" + time + ' ' + str + ' ' + std::to_string(sum) + " occurrence" + letterS + ".</p><ul>";
+	
+	for (auto i = 0u; i < 4u; ++i)
+	{
+		result += (i == 0u ? "<li>" : "</li><li>") + sides[i] + " wins " + HexDayAnalysis::FixedPoint(tally.ratio(i)) + '%';
+		auto oldCouple = 0u;
+		
+		for (const auto& event : HexDayAnalysis::eventIndex.bucket(level, i))
+			HexDayAnalysis::appendCouple(result, oldCouple, event);
+	}
+	
+	const auto bPE = tally.buyExpectation(HexDayAnalysis::takeProfit, HexDayAnalysis::stopLoss);
+	const auto sPE = tally.sellExpectation(HexDayAnalysis::takeProfit, HexDayAnalysis::stopLoss);
+	
+	result += "</li></ul><p.small>" + time + " Profit expectations: " + HexDayAnalysis::FixedPoint(bPE) + " (Buy) and " + HexDayAnalysis::FixedPoint(sPE) + " (Sell).</p>";
+	return result;
+}
+
+// Takes the outcomes of one of the last studies of the same candlesticks, if there is one for this TP and SL.
+bool HexDayAnalysis::recall(double tp, double sl)
+{
+	HexDayAnalysis::prepare();
+	
+	const auto memo = std::find_if(HexDayAnalysis::recentStudies.begin(), HexDayAnalysis::recentStudies.end(),
+					[tp, sl](const HexStudyMemo& m) { return m.takeProfit == tp and m.stopLoss == sl; });
 	
-	const auto bRatio = info[0u].size()*100./sum;
-	result += "<ul><li>Buy wins " + QString::number(bRatio, 'f', 2) + '%';
-	auto oldCouple = 0u;
+	if (memo == HexDayAnalysis::recentStudies.end())
+		return false;
 	
-	for (const auto& count : info[0u])
-		HexDayAnalysis::appendCouple(result, oldCouple, count);
+	HexDayAnalysis::candlesticks.winningOrders = memo->winningOrders;
+	HexDayAnalysis::takeProfit = tp;
+	HexDayAnalysis::stopLoss = sl;
+	HexDayAnalysis::finishStudy();
+	return true;
+}
+
+// The oldest of the recent studies makes room for the current one.
+void HexDayAnalysis::remember(void)
+{
+	if (HexDayAnalysis::recentStudies.size() == HexDayAnalysis::RecentStudies)
+		HexDayAnalysis::recentStudies.erase(HexDayAnalysis::recentStudies.begin());
 	
-	const auto sRatio = info[1u].size()*100./sum;
-	result += "</li><li>Sell wins " + QString::number(sRatio, 'f', 2) + '%';
-	oldCouple = 0u;
+	HexDayAnalysis::recentStudies.push_back({ HexDayAnalysis::takeProfit, HexDayAnalysis::stopLoss, HexDayAnalysis::candlesticks.winningOrders });
+}
+
+// Settles the sides the new candlestick reaches, with the distances the batch scans would find, and moves the
+// candlesticks whose outcome changed to their new count in the pyramid.
+void HexDayAnalysis::resolveOpenTrades(std::uint32_t index)
+{
+	const auto low = HexDayAnalysis::candlesticks.lows[index];
+	const auto high = HexDayAnalysis::candlesticks.highs[index];
+	auto kept = 0u;
 	
-	for (const auto& count : info[1u])
-		HexDayAnalysis::appendCouple(result, oldCouple, count);
+	for (auto& trade : HexDayAnalysis::openTrades)
+	{
+		if (trade.buyOpen and (low <= trade.buyLower or high >= trade.buyUpper))
+		{
+			trade.buy = (low > trade.buyLower ? index - trade.index - 1u : 50'000u);
+			trade.buyOpen = false;
+		}
+		
+		if (trade.sellOpen and (low <= trade.sellLower or high >= trade.sellUpper))
+		{
+			trade.sell = (high < trade.sellUpper ? index - trade.index - 1u : 50'000u);
+			trade.sellOpen = false;
+		}
+		
+		const auto verdict = HexDayAnalysis::Verdict(trade.buy, trade.sell);
+		auto& winningOrder = HexDayAnalysis::candlesticks.winningOrders[trade.index];
+		
+		if (verdict != winningOrder)
+		{
+			HexDayAnalysis::pyramid.recount(trade.index, winningOrder, verdict);
+			HexDayAnalysis::sampleDirtyFrom = std::min(HexDayAnalysis::sampleDirtyFrom, trade.index);
+			HexDayAnalysis::eventsNotIndexed = HexDayAnalysis::eventsNotIndexed or HexDayAnalysis::candlesticks.breaksOrDrops[trade.index] != '_';
+			winningOrder = verdict;
+		}
+		
+		if (trade.buyOpen or trade.sellOpen)
+			HexDayAnalysis::openTrades[kept++] = trade;
+	}
 	
-	const auto eRatio = info[2u].size()*100./sum;
-	result += "</li><li>Either wins " + QString::number(eRatio, 'f', 2) + '%';
-	oldCouple = 0u;
+	HexDayAnalysis::openTrades.resize(kept);
+}
+
+// Takes the outcomes of a study saved with studyCodes. The break and drop codes must match the classification of
+// the candlesticks, which turns away codes saved for other data; nothing changes when they are turned away.
+bool HexDayAnalysis::restoreStudy(double tp, double sl, const std::uint8_t* codes, std::uint32_t count)
+{
+	HexDayAnalysis::prepare();
 	
-	for (const auto& count : info[2u])
-		HexDayAnalysis::appendCouple(result, oldCouple, count);
+	if (count != HexDayAnalysis::candlesticks.size())
+		return false;
 	
-	const auto uRatio = info[3u].size()*100./sum;
-	result += "</li><li>Uncertainty wins " + QString::number(uRatio, 'f', 2) + '%';
-	oldCouple = 0u;
+	for (auto i = 0u; i < count; ++i)
+	{
+		const auto outcome = codes[i] & 7u;
+		const auto breakOrDrop = static_cast<std::uint32_t>(codes[i] >> 3);
+		
+		if (outcome >= HexDayAnalysis::OutcomeCodes.size() or breakOrDrop >= HexDayAnalysis::BreakCodes.size() or HexDayAnalysis::BreakCodes[breakOrDrop] != HexDayAnalysis::candlesticks.breaksOrDrops[i])
+			return false;
+	}
 	
-	for (const auto& count : info[3u])
-		HexDayAnalysis::appendCouple(result, oldCouple, count);
+	for (auto i = 0u; i < count; ++i)
+		HexDayAnalysis::candlesticks.winningOrders[i] = HexDayAnalysis::OutcomeCodes[codes[i] & 7u];
 	
-	const auto bPE = HexDayAnalysis::takeProfit*(bRatio + eRatio)/100. - HexDayAnalysis::stopLoss*sRatio/100.;
-	const auto sPE = HexDayAnalysis::takeProfit*(sRatio + eRatio)/100. - HexDayAnalysis::stopLoss*bRatio/100.;
+	HexDayAnalysis::takeProfit = tp;
+	HexDayAnalysis::stopLoss = sl;
+	HexDayAnalysis::remember();
+	HexDayAnalysis::finishStudy();
+	return true;
+}
+
+// The strips of the sample ring from that one on, in time order.
+std::vector<HexStrip> HexDayAnalysis::ringStrips(std::uint32_t first) const
+{
+	const auto& ring = HexDayAnalysis::sampleRing;
+	const auto numberOfCandlesticks = static_cast<std::uint32_t>(ring.size());
+	std::vector<HexStrip> foo;
+	foo.reserve(numberOfCandlesticks - std::min(first, numberOfCandlesticks));
 	
-	result += "</li></ul><p.small>" + time + " Profit expectations: " + QString::number(bPE, 'f', 2) + " (Buy) and " + QString::number(sPE, 'f', 2) + " (Sell).</p>";
-	return result;
+	for (auto i = first; i < numberOfCandlesticks; ++i)
+		foo.push_back(ring[(HexDayAnalysis::sampleHead + i) % numberOfCandlesticks]);
+	
+	return foo;
+}
+
+void HexDayAnalysis::saveCandlestick(double low, double high)
+{
+	HexDayAnalysis::candlesticks.append(low, high);
+	HexDayAnalysis::classificationNotCompleted = true;
+	HexDayAnalysis::sampleNotReusable = true;
 }
 
-void HexDayAnalysis::saveCandlestick(qreal low, qreal high)
+void HexDayAnalysis::saveCandlesticks(const std::int32_t* lowTicks, const std::int32_t* highTicks, std::uint32_t count)
 {
-	HexDayAnalysis::candlesticks.emplace_back(low, high);
+	HexDayAnalysis::candlesticks.reserve(HexDayAnalysis::candlesticks.size() + count);
+	
+	for (auto i = 0u; i < count; ++i)
+		HexDayAnalysis::candlesticks.append(lowTicks[i]*0.25, highTicks[i]*0.25);
+	
+	HexDayAnalysis::classificationNotCompleted = true;
+	HexDayAnalysis::sampleNotReusable = true;
 }
 
-void HexDayAnalysis::setMaxima(qreal d, qreal w, qreal m, qreal y)
+void HexDayAnalysis::setMaxima(double d, double w, double m, double y)
 {
 	HexDayAnalysis::dInfo.max = d;
 	HexDayAnalysis::wInfo.max = w;
@@ -227,9 +613,11 @@ void HexDayAnalysis::setMaxima(qreal d, qreal w, qreal m, qreal y)
 	HexDayAnalysis::wInfo.rawMax = w;
 	HexDayAnalysis::mInfo.rawMax = m;
 	HexDayAnalysis::yInfo.rawMax = y;
+	HexDayAnalysis::classificationNotCompleted = true;
+	HexDayAnalysis::sampleNotReusable = true;
 }
 
-void HexDayAnalysis::setMinima(qreal d, qreal w, qreal m, qreal y)
+void HexDayAnalysis::setMinima(double d, double w, double m, double y)
 {
 	HexDayAnalysis::dInfo.min = d;
 	HexDayAnalysis::wInfo.min = w;
@@ -240,232 +628,306 @@ void HexDayAnalysis::setMinima(qreal d, qreal w, qreal m, qreal y)
 	HexDayAnalysis::wInfo.rawMin = w;
 	HexDayAnalysis::mInfo.rawMin = m;
 	HexDayAnalysis::yInfo.rawMin = y;
+	HexDayAnalysis::classificationNotCompleted = true;
+	HexDayAnalysis::sampleNotReusable = true;
+}
+
+// Candlesticks of a file are spread evenly over the 23'400 seconds of the session; live ones are one per second.
+std::uint32_t HexDayAnalysis::secondOf(std::uint32_t index) const
+{
+	if (HexDayAnalysis::live)
+		return index;
+	
+	return static_cast<std::uint32_t>(index*23'400u/HexDayAnalysis::candlesticks.size());
 }
 
-quint32 HexDayAnalysis::strictBuyAndSell(std::vector<HexCandlestick>::const_iterator it, qreal lowerPriceLimit, qreal upperPriceLimit) const
+// The last sample is kept as a ring of strips. When the window moves by a whole number of strips, only the strips
+// entering it are aggregated and the ring head moves over the ones leaving it, and a window that grows on the right
+// only aggregates the new strips. Strips holding candlesticks that were appended or whose outcome changed since then
+// are aggregated again. The first strip that changed is returned, or the number of strips when none did.
+std::uint32_t HexDayAnalysis::slideRing(std::uint32_t start, std::uint32_t numberOfCandlesticks, std::uint32_t secondsPerCandlestick)
 {
-	const auto end = HexDayAnalysis::candlesticks.cend();
-	auto count = 0u;
+	auto& ring = HexDayAnalysis::sampleRing;
+	const auto distance = static_cast<std::int64_t>(start) - static_cast<std::int64_t>(HexDayAnalysis::sampleStart);
+	const auto shift = distance/static_cast<std::int64_t>(secondsPerCandlestick);
+	auto firstChanged = numberOfCandlesticks;
 	
-	while (it != end and it->high < upperPriceLimit)
+	if (!HexDayAnalysis::sampleNotReusable and HexDayAnalysis::sampleHead == 0u and HexDayAnalysis::sampleUnit == secondsPerCandlestick and distance == 0 and
+		numberOfCandlesticks > ring.size())
+	{
+		firstChanged = static_cast<std::uint32_t>(ring.size());
+		auto entering = HexDayAnalysis::extractCandlestickData(start + firstChanged*secondsPerCandlestick, numberOfCandlesticks - firstChanged, secondsPerCandlestick);
+		ring.insert(ring.end(), std::make_move_iterator(entering.begin()), std::make_move_iterator(entering.end()));
+	}
+	else if (HexDayAnalysis::sampleNotReusable or ring.size() != numberOfCandlesticks or HexDayAnalysis::sampleUnit != secondsPerCandlestick or
+		distance % static_cast<std::int64_t>(secondsPerCandlestick) != 0 or std::abs(shift) >= static_cast<std::int64_t>(numberOfCandlesticks))
+	{
+		ring = HexDayAnalysis::extractCandlestickData(start, numberOfCandlesticks, secondsPerCandlestick);
+		HexDayAnalysis::sampleHead = 0u;
+		HexDayAnalysis::sampleDirtyFrom = std::numeric_limits<std::uint32_t>::max();
+		firstChanged = 0u;
+	}
+	else if (shift > 0)
+	{
+		const auto count = static_cast<std::uint32_t>(shift);
+		auto entering = HexDayAnalysis::extractCandlestickData(start + (numberOfCandlesticks - count)*secondsPerCandlestick, count, secondsPerCandlestick);
+		
+		for (auto i = 0u; i < count; ++i)
+			ring[(HexDayAnalysis::sampleHead + i) % numberOfCandlesticks] = std::move(entering[i]);
+		
+		HexDayAnalysis::sampleHead = (HexDayAnalysis::sampleHead + count) % numberOfCandlesticks;
+		firstChanged = 0u;
+	}
+	else if (shift < 0)
 	{
-		if (it->low <= lowerPriceLimit)
-			return 50'000u;
+		const auto count = static_cast<std::uint32_t>(-shift);
+		auto entering = HexDayAnalysis::extractCandlestickData(start, count, secondsPerCandlestick);
+		HexDayAnalysis::sampleHead = (HexDayAnalysis::sampleHead + numberOfCandlesticks - count) % numberOfCandlesticks;
+		
+		for (auto i = 0u; i < count; ++i)
+			ring[(HexDayAnalysis::sampleHead + i) % numberOfCandlesticks] = std::move(entering[i]);
 		
-		++it;
-		++count;
+		firstChanged = 0u;
 	}
 	
-	return (it != end and lowerPriceLimit < it->low ? count : 50'000u);
-}
-
-quint32 HexDayAnalysis::strictSellAndBuy(std::vector<HexCandlestick>::const_iterator it, qreal lowerPriceLimit, qreal upperPriceLimit) const
-{
-	const auto end = HexDayAnalysis::candlesticks.cend();
-	auto count = 0u;
+	const auto sampleEnd = start + numberOfCandlesticks*secondsPerCandlestick;
 	
-	while (it != end and lowerPriceLimit < it->low)
+	if (HexDayAnalysis::sampleDirtyFrom < sampleEnd)
 	{
-		if (upperPriceLimit <= it->high)
-			return 50'000u;
+		const auto firstDirty = (HexDayAnalysis::sampleDirtyFrom > start ? (HexDayAnalysis::sampleDirtyFrom - start)/secondsPerCandlestick : 0u);
+		auto refreshed = HexDayAnalysis::extractCandlestickData(start + firstDirty*secondsPerCandlestick, numberOfCandlesticks - firstDirty, secondsPerCandlestick);
+		
+		for (auto i = firstDirty; i < numberOfCandlesticks; ++i)
+			ring[(HexDayAnalysis::sampleHead + i) % numberOfCandlesticks] = std::move(refreshed[i - firstDirty]);
 		
-		++it;
-		++count;
+		firstChanged = std::min(firstChanged, firstDirty);
 	}
 	
-	return (it != end and it->high < upperPriceLimit ? count : 50'000u);
+	HexDayAnalysis::sampleDirtyFrom = std::numeric_limits<std::uint32_t>::max();
+	HexDayAnalysis::sampleStart = start;
+	HexDayAnalysis::sampleUnit = secondsPerCandlestick;
+	HexDayAnalysis::sampleNotReusable = false;
+	return firstChanged;
 }
 
-void HexDayAnalysis::study(qreal tp, qreal sl)
+std::vector<HexStrip> HexDayAnalysis::slideSample(std::uint32_t start, std::uint32_t numberOfCandlesticks, std::uint32_t secondsPerCandlestick)
 {
+	HexDayAnalysis::slideRing(start, numberOfCandlesticks, secondsPerCandlestick);
+	return HexDayAnalysis::ringStrips(0u);
+}
+
+// Most outcomes are decided within a few dozen seconds, so the first ScanWindow candlesticks are scanned linearly
+// with the vector kernel. Only when nothing happens there do the sparse tables take over.
+std::uint32_t HexDayAnalysis::strictBuyAndSell(std::uint32_t start, double lowerPriceLimit, double upperPriceLimit) const
+{
+	const auto& cs = HexDayAnalysis::candlesticks;
+	const auto size = static_cast<std::uint32_t>(cs.size());
+	const auto windowEnd = std::min(start + HexDayAnalysis::ScanWindow, size);
+	const auto crossing = HexForwardScan::FirstCrossing(cs.lows.data(), cs.highs.data(), start, windowEnd, lowerPriceLimit, upperPriceLimit);
+	
+	if (crossing < windowEnd)
+		return (cs.lows[crossing] > lowerPriceLimit ? crossing - start : 50'000u);
+	
+	const auto target = HexDayAnalysis::extremumTable.firstHighAtLeast(windowEnd, upperPriceLimit);
+	
+	if (target == size)
+		return 50'000u;
+	
+	const auto stop = HexDayAnalysis::extremumTable.firstLowAtMost(windowEnd, lowerPriceLimit);
+	return (target < stop ? target - start : 50'000u);
+}
+
+std::uint32_t HexDayAnalysis::strictSellAndBuy(std::uint32_t start, double lowerPriceLimit, double upperPriceLimit) const
+{
+	const auto& cs = HexDayAnalysis::candlesticks;
+	const auto size = static_cast<std::uint32_t>(cs.size());
+	const auto windowEnd = std::min(start + HexDayAnalysis::ScanWindow, size);
+	const auto crossing = HexForwardScan::FirstCrossing(cs.lows.data(), cs.highs.data(), start, windowEnd, lowerPriceLimit, upperPriceLimit);
+	
+	if (crossing < windowEnd)
+		return (cs.highs[crossing] < upperPriceLimit ? crossing - start : 50'000u);
+	
+	const auto target = HexDayAnalysis::extremumTable.firstLowAtMost(windowEnd, lowerPriceLimit);
+	
+	if (target == size)
+		return 50'000u;
+	
+	const auto stop = HexDayAnalysis::extremumTable.firstHighAtLeast(windowEnd, upperPriceLimit);
+	return (target < stop ? target - start : 50'000u);
+}
+
+std::uint32_t HexDayAnalysis::size(void) const
+{
+	return static_cast<std::uint32_t>(HexDayAnalysis::candlesticks.size());
+}
+
+void HexDayAnalysis::study(double tp, double sl)
+{
+	HEX_PROFILE_SCOPE("HexDayAnalysis::study");
+	
+	if (HexDayAnalysis::recall(tp, sl))
+		return;
+	
 	HexDayAnalysis::takeProfit = tp;
 	HexDayAnalysis::stopLoss = sl;
 	
-	dInfo.min = dInfo.rawMin;
-	wInfo.min = wInfo.rawMin;
-	mInfo.min = mInfo.rawMin;
-	yInfo.min = yInfo.rawMin;
+	for (auto i = 0u; i < HexDayAnalysis::candlesticks.size(); ++i)
+		HexDayAnalysis::candlesticks.winningOrders[i] = HexDayAnalysis::outcome(i, tp, sl);
 	
-	dInfo.max = dInfo.rawMax;
-	wInfo.max = wInfo.rawMax;
-	mInfo.max = mInfo.rawMax;
-	yInfo.max = yInfo.rawMax;
-	
-	auto it = HexDayAnalysis::candlesticks.cbegin();
+	HexDayAnalysis::remember();
+	HexDayAnalysis::finishStudy();
+}
+
+// One byte per candlestick: the outcome in the low three bits and the break or drop code in the next four.
+std::vector<std::uint8_t> HexDayAnalysis::studyCodes(void) const
+{
+	const auto& cs = HexDayAnalysis::candlesticks;
+	std::vector<std::uint8_t> codes(cs.size());
 	
-	for (auto& cs : HexDayAnalysis::candlesticks)
+	for (auto i = 0u; i < codes.size(); ++i)
 	{
-		HexDayAnalysis::update(cs);
-		
-		const auto buyPrice = (cs.breakOrDrop != '_' ? cs.levelToBuyOrSell : cs.high);
-		const auto buy = HexDayAnalysis::strictBuyAndSell(it + 1u, buyPrice - sl, buyPrice + tp);
-		
-		const auto sellPrice = (cs.breakOrDrop != '_' ? cs.levelToBuyOrSell : cs.low);
-		const auto sell = HexDayAnalysis::strictSellAndBuy(it + 1u, sellPrice - tp, sellPrice + sl);
-		
-		if (buy > sell)
-			cs.winningOrder = (buy > 23'400u ? 'S' : 's');
-		else if (buy < sell)
-			cs.winningOrder = (sell > 23'400u ? 'B' : 'b');
-		else
-			cs.winningOrder = (buy > 23'400u ? 'u' : 'e');
-		
-		++it;
+		const auto outcome = std::find(HexDayAnalysis::OutcomeCodes.begin(), HexDayAnalysis::OutcomeCodes.end(), cs.winningOrders[i]) - HexDayAnalysis::OutcomeCodes.begin();
+		const auto breakOrDrop = std::find(HexDayAnalysis::BreakCodes.begin(), HexDayAnalysis::BreakCodes.end(), cs.breaksOrDrops[i]) - HexDayAnalysis::BreakCodes.begin();
+		codes[i] = static_cast<std::uint8_t>(outcome | breakOrDrop << 3);
 	}
 	
-	HexDayAnalysis::studyNotCompleted = false;
+	return codes;
 }
 
-QString HexDayAnalysis::sumUpBreaksAndDrops(const QString& time) const
+std::string HexDayAnalysis::sumUpBreaksAndDrops(const std::string& time) const
 {
-	std::array<std::vector<quint32>, 4u> dBreaks = { };
-	std::array<std::vector<quint32>, 4u> wBreaks = { };
-	std::array<std::vector<quint32>, 4u> mBreaks = { };
-	std::array<std::vector<quint32>, 4u> yBreaks = { };
+	static const std::array<std::string, 8u> titles = { "Day breaks info!", "Week breaks info!", "Month breaks info!", "Year breaks info!",
+							"Day drops info!", "Week drops info!", "Month drops info!", "Year drops info!" };
 	
-	std::array<std::vector<quint32>, 4u> dDrops = { };
-	std::array<std::vector<quint32>, 4u> wDrops = { };
-	std::array<std::vector<quint32>, 4u> mDrops = { };
-	std::array<std::vector<quint32>, 4u> yDrops = { };
+	std::string aftermath = "";
 	
-	auto count = 0u;
+	for (auto i = 0u; i < HexEventIndex::Levels; ++i)
+		aftermath += HexDayAnalysis::record(time, titles[i], i);
 	
-	for (const auto& cs : HexDayAnalysis::candlesticks)
+	return aftermath;
+}
+
+// Per level and half hour of the session, the last one closing the day.
+std::array<std::array<HexLevelTally, 13u>, 8u> HexDayAnalysis::tallyBreaksAndDrops(double tp, double sl)
+{
+	HexDayAnalysis::prepare();
+	
+	std::array<std::array<HexLevelTally, 13u>, 8u> tallies = { };
+	
+	for (const auto& count : HexDayAnalysis::breaksAndDrops)
 	{
-		if (cs.breakOrDrop != '_')
-		{
-			quint32 index = 3u;
-			
-			switch (cs.winningOrder)
-			{
-				case 'B':
-					index = 0u;
-					break;
-				
-				case 'S':
-					index = 1u;
-					break;
-				
-				case 'b':
-				case 'e':
-				case 's':
-					index = 2u;
-					break;
-			}
-			
-			switch (cs.breakOrDrop)
-			{
-				case 'y':
-					yDrops[index].push_back(count);
-					break; //[[fallthrough]];
-				
-				case 'm':
-					mDrops[index].push_back(count);
-					break; //[[fallthrough]];
-				
-				case 'w':
-					wDrops[index].push_back(count);
-					break; //[[fallthrough]];
-				
-				case 'd':
-					dDrops[index].push_back(count);
-					break;
-				
-				case 'Y':
-					yBreaks[index].push_back(count);
-					break; //[[fallthrough]];
-				
-				case 'M':
-					mBreaks[index].push_back(count);
-					break; //[[fallthrough]];
-				
-				case 'W':
-					wBreaks[index].push_back(count);
-					break; //[[fallthrough]];
-				
-				case 'D':
-					dBreaks[index].push_back(count);
-					break;
-			}
-		}
-		
-		++count;
+		const auto level = HexDayAnalysis::LevelIndex(HexDayAnalysis::candlesticks.breaksOrDrops[count]);
+		const auto halfHour = std::min(HexDayAnalysis::secondOf(count)/1'800u, 12u);
+		tallies[level][halfHour].add(HexDayAnalysis::outcome(count, tp, sl));
 	}
 	
-	QString aftermath = "";
-	aftermath += HexDayAnalysis::record(time, "Day breaks info!", dBreaks);
-	aftermath += HexDayAnalysis::record(time, "Week breaks info!", wBreaks);
-	aftermath += HexDayAnalysis::record(time, "Month breaks info!", mBreaks);
-	aftermath += HexDayAnalysis::record(time, "Year breaks info!", yBreaks);
-	aftermath += HexDayAnalysis::record(time, "Day drops info!", dDrops);
-	aftermath += HexDayAnalysis::record(time, "Week drops info!", wDrops);
-	aftermath += HexDayAnalysis::record(time, "Month drops info!", mDrops);
-	aftermath += HexDayAnalysis::record(time, "Year drops info!", yDrops);
-	return aftermath;
+	return tallies;
 }
 
-QString HexDayAnalysis::timeString(quint32 timeSpot) const
+std::string HexDayAnalysis::timeString(std::uint32_t timeSpot) const
 {
-	const auto timestamp = timeSpot*23'400u/HexDayAnalysis::candlesticks.size();
+	const auto timestamp = HexDayAnalysis::secondOf(timeSpot);
 	const auto hour = 15u + (timestamp + 1'800u)/3'600u;
 	const auto minute = (30u + timestamp/60u) % 60u;
 	const auto second = timestamp % 60u;
 	
-	const QString zeroPadding1 = (minute < 10u ? "0" : "");
-	const QString zeroPadding2 = (second < 10u ? "0" : "");
-	return QString::number(hour) + ':' + zeroPadding1 + QString::number(minute) + ':' + zeroPadding2 + QString::number(second);
+	const std::string zeroPadding1 = (minute < 10u ? "0" : "");
+	const std::string zeroPadding2 = (second < 10u ? "0" : "");
+	return std::to_string(hour) + ':' + zeroPadding1 + std::to_string(minute) + ':' + zeroPadding2 + std::to_string(second);
+}
+
+// Rebuilds the open trades of a freshly studied day: the sides that neither reached their target nor their stop
+// by the last candlestick. Streaming then keeps the list current one candlestick at a time.
+void HexDayAnalysis::trackOpenTrades(void)
+{
+	HexDayAnalysis::prepare();
+	HexDayAnalysis::openTrades.clear();
+	
+	const auto size = static_cast<std::uint32_t>(HexDayAnalysis::candlesticks.size());
+	const auto& table = HexDayAnalysis::extremumTable;
+	
+	for (auto i = 0u; i < size; ++i)
+	{
+		auto trade = HexDayAnalysis::openTrade(i);
+		trade.buy = HexDayAnalysis::strictBuyAndSell(i + 1u, trade.buyLower, trade.buyUpper);
+		trade.sell = HexDayAnalysis::strictSellAndBuy(i + 1u, trade.sellLower, trade.sellUpper);
+		trade.buyOpen = (trade.buy == 50'000u and table.firstLowAtMost(i + 1u, trade.buyLower) >= size and table.firstHighAtLeast(i + 1u, trade.buyUpper) >= size);
+		trade.sellOpen = (trade.sell == 50'000u and table.firstLowAtMost(i + 1u, trade.sellLower) >= size and table.firstHighAtLeast(i + 1u, trade.sellUpper) >= size);
+		
+		if (trade.buyOpen or trade.sellOpen)
+			HexDayAnalysis::openTrades.push_back(trade);
+	}
+	
+	HexDayAnalysis::tradesNotTracked = false;
 }
 
-void HexDayAnalysis::update(HexCandlestick& cs)
+void HexDayAnalysis::update(std::uint32_t index)
 {
-	if (HexDayAnalysis::dInfo.min > cs.low)
+	const auto low = HexDayAnalysis::candlesticks.lows[index];
+	const auto high = HexDayAnalysis::candlesticks.highs[index];
+	auto& levelToBuyOrSell = HexDayAnalysis::candlesticks.levelsToBuyOrSell[index];
+	auto& breakOrDrop = HexDayAnalysis::candlesticks.breaksOrDrops[index];
+	
+	if (HexDayAnalysis::dInfo.min > low)
 	{
-		cs.levelToBuyOrSell = HexDayAnalysis::dInfo.min - 0.25;
-		HexDayAnalysis::dInfo.min = cs.low;
-		cs.breakOrDrop = 'd';
+		levelToBuyOrSell = HexDayAnalysis::dInfo.min - 0.25;
+		HexDayAnalysis::dInfo.min = low;
+		breakOrDrop = 'd';
 		
-		if (HexDayAnalysis::wInfo.min > cs.low)
+		if (HexDayAnalysis::wInfo.min > low)
 		{
-			HexDayAnalysis::wInfo.min = cs.low;
-			cs.breakOrDrop = 'w';
+			HexDayAnalysis::wInfo.min = low;
+			breakOrDrop = 'w';
 			
-			if (HexDayAnalysis::mInfo.min > cs.low)
+			if (HexDayAnalysis::mInfo.min > low)
 			{
-				HexDayAnalysis::mInfo.min = cs.low;
-				cs.breakOrDrop = 'm';
+				HexDayAnalysis::mInfo.min = low;
+				breakOrDrop = 'm';
 				
-				if (HexDayAnalysis::yInfo.min > cs.low)
+				if (HexDayAnalysis::yInfo.min > low)
 				{
-					HexDayAnalysis::yInfo.min = cs.low;
-					cs.breakOrDrop = 'y';
+					HexDayAnalysis::yInfo.min = low;
+					breakOrDrop = 'y';
 				}
 			}
 		}
 	}
-	else if (HexDayAnalysis::dInfo.max < cs.high)
+	else if (HexDayAnalysis::dInfo.max < high)
 	{
-		cs.levelToBuyOrSell = HexDayAnalysis::dInfo.max + 0.25;
-		HexDayAnalysis::dInfo.max = cs.high;
-		cs.breakOrDrop = 'D';
+		levelToBuyOrSell = HexDayAnalysis::dInfo.max + 0.25;
+		HexDayAnalysis::dInfo.max = high;
+		breakOrDrop = 'D';
 		
-		if (HexDayAnalysis::wInfo.max < cs.high)
+		if (HexDayAnalysis::wInfo.max < high)
 		{
-			HexDayAnalysis::wInfo.max = cs.high;
-			cs.breakOrDrop = 'W';
+			HexDayAnalysis::wInfo.max = high;
+			breakOrDrop = 'W';
 			
-			if (HexDayAnalysis::mInfo.max < cs.high)
+			if (HexDayAnalysis::mInfo.max < high)
 			{
-				HexDayAnalysis::mInfo.max = cs.high;
-				cs.breakOrDrop = 'M';
+				HexDayAnalysis::mInfo.max = high;
+				breakOrDrop = 'M';
 				
-				if (HexDayAnalysis::yInfo.max < cs.high)
+				if (HexDayAnalysis::yInfo.max < high)
 				{
-					HexDayAnalysis::yInfo.max = cs.high;
-					cs.breakOrDrop = 'Y';
+					HexDayAnalysis::yInfo.max = high;
+					breakOrDrop = 'Y';
 				}
 			}
 		}
 	}
 }
 
+// The outcome of a candlestick from the distances to the wins of its buy and sell trades, 50'000 meaning never.
+char HexDayAnalysis::Verdict(std::uint32_t buy, std::uint32_t sell)
+{
+	if (buy > sell)
+		return (buy > 23'400u ? 'S' : 's');
+	
+	if (buy < sell)
+		return (sell > 23'400u ? 'B' : 'b');
+	
+	return (buy > 23'400u ? 'u' : 'e');
+}
+
 #endif
@@ -0,0 +1,411 @@
+#ifndef __HEX_DAY_ARCHIVE_HPP__
+#define __HEX_DAY_ARCHIVE_HPP__
+
+// Qt Libraries
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QStandardPaths>
+#include <QtConcurrent/QtConcurrentMap>
+
+// Standard Libraries
+#include <algorithm>
+#include <list>
+#include <memory>
+#include <vector>
+
+// Personal Libraries
+#include "HexBinaryDay.hpp"
+#include "HexDayAnalysis.hpp"
+#include "HexTextParser.hpp"
+
+// Every day file (.txt or .hexd) found under a root directory, keyed by instrument and date and sorted that way.
+// The index is persisted in the cache directory, named after the root, so the data tree is never written to. Only
+// files whose size or modification time changed are re-read on refresh. The most recently used days are kept decoded
+// in memory.
+class HexDayArchive
+{
+	private:
+	
+		inline static bool			IndexFile(const QFileInfo&, HexArchiveEntry&);
+		
+		QDir					indexDirectory;
+		QString					rootPath;
+		std::vector<HexArchiveEntry>		entries;
+		std::list<std::pair<QString, std::shared_ptr<HexDayAnalysis>>>	recentDays;
+		quint32					capacity;
+		
+		inline void				evict(const QString&);
+		inline QString				indexPath(void) const;
+		inline bool				isIndexed(const QString&, const QHash<QString, quint32>&) const;
+		inline bool				loadIndex(void);
+		inline void				saveIndex(void) const;
+	
+	public:
+	
+		inline					HexDayArchive(quint32 = 8u, const QString& = HexDayArchive::DefaultDirectory());
+		
+		inline static QString			DefaultDirectory(void);
+		inline static HexParseReport		LoadDay(const QString&, std::shared_ptr<HexDayAnalysis>&);
+		
+		inline std::shared_ptr<HexDayAnalysis>	day(quint32, HexParseReport&);
+		inline std::vector<std::shared_ptr<HexDayAnalysis>>	days(const std::vector<quint32>&);
+		inline const HexArchiveEntry&		entry(quint32) const;
+		inline qint32				find(const QString&) const;
+		inline void				insert(quint32, const std::shared_ptr<HexDayAnalysis>&);
+		inline qint32				neighbour(quint32, qint32) const;
+		inline bool				open(const QString&);
+		inline bool				refresh(void);
+		inline const QString&			root(void) const;
+		inline std::vector<quint32>		sameDate(quint32) const;
+		inline quint32				size(void) const;
+};
+
+HexDayArchive::HexDayArchive(quint32 numberOfDays, const QString& path) : indexDirectory(path), capacity(std::max(numberOfDays, 1u))
+{
+	HexDayArchive::indexDirectory.mkpath(".");
+}
+
+// A day that cannot be decoded comes back null, with the report of its parser.
+std::shared_ptr<HexDayAnalysis> HexDayArchive::day(quint32 index, HexParseReport& report)
+{
+	const auto& filePath = HexDayArchive::entries[index].filePath;
+	
+	for (auto it = HexDayArchive::recentDays.begin(); it != HexDayArchive::recentDays.end(); ++it)
+	{
+		if (it->first == filePath)
+		{
+			HexDayArchive::recentDays.splice(HexDayArchive::recentDays.begin(), HexDayArchive::recentDays, it);
+			report.error = HexParseReport::None;
+			return it->second;
+		}
+	}
+	
+	std::shared_ptr<HexDayAnalysis> analysis;
+	report = HexDayArchive::LoadDay(filePath, analysis);
+	
+	if (analysis != nullptr)
+		HexDayArchive::insert(index, analysis);
+	
+	return analysis;
+}
+
+// Like day for several entries, but those not in memory are decoded in parallel.
+std::vector<std::shared_ptr<HexDayAnalysis>> HexDayArchive::days(const std::vector<quint32>& indices)
+{
+	std::vector<std::shared_ptr<HexDayAnalysis>> result(indices.size());
+	std::vector<quint32> missing;
+	
+	for (auto i = 0u; i < indices.size(); ++i)
+	{
+		const auto& filePath = HexDayArchive::entries[indices[i]].filePath;
+		const auto recentDay = std::find_if(HexDayArchive::recentDays.begin(), HexDayArchive::recentDays.end(), [&](const auto& d) { return d.first == filePath; });
+		
+		if (recentDay != HexDayArchive::recentDays.end())
+			result[i] = recentDay->second;
+		else
+			missing.push_back(i);
+	}
+	
+	QtConcurrent::blockingMap(missing, [&](quint32 i) { HexDayArchive::LoadDay(HexDayArchive::entries[indices[i]].filePath, result[i]); });
+	
+	for (auto i = 0u; i < indices.size(); ++i)
+		if (result[i] != nullptr)
+			HexDayArchive::insert(indices[i], result[i]);
+	
+	return result;
+}
+
+QString HexDayArchive::DefaultDirectory(void)
+{
+	return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/archives";
+}
+
+const HexArchiveEntry& HexDayArchive::entry(quint32 index) const
+{
+	return HexDayArchive::entries[index];
+}
+
+void HexDayArchive::evict(const QString& filePath)
+{
+	HexDayArchive::recentDays.remove_if([&](const auto& recentDay) { return recentDay.first == filePath; });
+}
+
+qint32 HexDayArchive::find(const QString& filePath) const
+{
+	const QFileInfo info(filePath);
+	const auto absolutePath = info.absoluteFilePath();
+	
+	for (auto i = 0u; i < HexDayArchive::entries.size(); ++i)
+		if (HexDayArchive::entries[i].filePath == absolutePath)
+			return static_cast<qint32>(i);
+	
+	const auto parts = info.completeBaseName().split('_');
+	
+	if (parts.size() < 2)
+		return -1;
+	
+	for (auto i = 0u; i < HexDayArchive::entries.size(); ++i)
+		if (HexDayArchive::entries[i].instrument == parts[0u] and HexDayArchive::entries[i].date == parts[1u])
+			return static_cast<qint32>(i);
+	
+	return -1;
+}
+
+bool HexDayArchive::IndexFile(const QFileInfo& info, HexArchiveEntry& entry)
+{
+	const auto parts = info.completeBaseName().split('_');
+	entry.instrument = (parts.size() >= 2 ? parts[0u] : info.dir().dirName());
+	entry.date = (parts.size() >= 2 ? parts[1u] : info.completeBaseName());
+	entry.filePath = info.absoluteFilePath();
+	entry.fileSize = info.size();
+	entry.lastModified = info.lastModified().toMSecsSinceEpoch();
+	
+	QFile dataFile(entry.filePath);
+	
+	if (!dataFile.open(QIODevice::ReadOnly))
+		return false;
+	
+	if (info.suffix() == "hexd")
+	{
+		HexBinaryHeader header;
+		
+		if (dataFile.read(reinterpret_cast<char*>(&header), sizeof(HexBinaryHeader)) != static_cast<qint64>(sizeof(HexBinaryHeader)) or header.magic != HexBinaryHeader().magic)
+			return false;
+		
+		entry.minima = header.minima;
+		entry.maxima = header.maxima;
+		entry.numberOfCandlesticks = header.numberOfCandlesticks;
+		return true;
+	}
+	
+	const auto content = dataFile.readAll();
+	const auto text = std::string_view(content.constData(), static_cast<std::size_t>(content.size()));
+	return (HexTextParser::Parse(text, entry).error == HexParseReport::None);
+}
+
+QString HexDayArchive::indexPath(void) const
+{
+	const auto rootHash = QCryptographicHash::hash(HexDayArchive::rootPath.toUtf8(), QCryptographicHash::Sha1).toHex();
+	return HexDayArchive::indexDirectory.filePath(QString::fromLatin1(rootHash) + ".hexindex");
+}
+
+void HexDayArchive::insert(quint32 index, const std::shared_ptr<HexDayAnalysis>& analysis)
+{
+	const auto& filePath = HexDayArchive::entries[index].filePath;
+	HexDayArchive::evict(filePath);
+	HexDayArchive::recentDays.emplace_front(filePath, analysis);
+	
+	while (HexDayArchive::recentDays.size() > HexDayArchive::capacity)
+		HexDayArchive::recentDays.pop_back();
+}
+
+// Whether that file is in the index and unchanged on disk. A .txt day whose converted .hexd is, is shadowed by it and
+// not parsed again.
+bool HexDayArchive::isIndexed(const QString& filePath, const QHash<QString, quint32>& knownFiles) const
+{
+	const auto known = knownFiles.constFind(filePath);
+	
+	if (known == knownFiles.cend())
+		return false;
+	
+	const QFileInfo info(filePath);
+	const auto& e = HexDayArchive::entries[known.value()];
+	return (info.exists() and e.fileSize == info.size() and e.lastModified == info.lastModified().toMSecsSinceEpoch());
+}
+
+// A .hexd file only tells whether it could be read; a .txt file reports the line it stopped at. The analysis is null
+// unless the day was decoded.
+HexParseReport HexDayArchive::LoadDay(const QString& filePath, std::shared_ptr<HexDayAnalysis>& analysis)
+{
+	HexParseReport report;
+	analysis = std::make_shared<HexDayAnalysis>();
+	
+	if (filePath.endsWith(".hexd"))
+		report.error = (HexBinaryDay::Load(filePath, *analysis) ? HexParseReport::None : HexParseReport::InvalidBinaryFile);
+	else
+		report = HexTextParser::Parse(filePath, *analysis);
+	
+	if (report.error != HexParseReport::None)
+		analysis = nullptr;
+	
+	return report;
+}
+
+bool HexDayArchive::loadIndex(void)
+{
+	QFile indexFile(HexDayArchive::indexPath());
+	
+	if (!indexFile.open(QIODevice::ReadOnly))
+		return false;
+	
+	QDataStream stream(&indexFile);
+	quint32 magic = 0u;
+	quint32 version = 0u;
+	quint32 count = 0u;
+	stream >> magic >> version >> count;
+	
+	if (magic != 0x48455849u or version != 2u)
+		return false;
+	
+	const QDir root(HexDayArchive::rootPath);
+	std::vector<HexArchiveEntry> loadedEntries(count);
+	
+	for (auto& e : loadedEntries)
+	{
+		QString relativePath;
+		stream >> e.instrument >> e.date >> relativePath >> e.fileSize >> e.lastModified >> e.numberOfCandlesticks;
+		
+		for (auto i = 0u; i < 4u; ++i)
+			stream >> e.minima[i] >> e.maxima[i];
+		
+		e.filePath = root.absoluteFilePath(relativePath);
+	}
+	
+	if (stream.status() != QDataStream::Ok)
+		return false;
+	
+	HexDayArchive::entries.swap(loadedEntries);
+	return true;
+}
+
+qint32 HexDayArchive::neighbour(quint32 index, qint32 step) const
+{
+	const auto target = static_cast<qint64>(index) + step;
+	
+	if (target < 0 or target >= static_cast<qint64>(HexDayArchive::entries.size()))
+		return -1;
+	
+	if (HexDayArchive::entries[static_cast<quint32>(target)].instrument != HexDayArchive::entries[index].instrument)
+		return -1;
+	
+	return static_cast<qint32>(target);
+}
+
+// Whether the root changed, in which case the persisted index is loaded and still needs a refresh.
+bool HexDayArchive::open(const QString& directory)
+{
+	const auto absolutePath = QDir::cleanPath(QDir(directory).absolutePath());
+	
+	if (absolutePath == HexDayArchive::rootPath)
+		return false;
+	
+	HexDayArchive::rootPath = absolutePath;
+	HexDayArchive::entries.clear();
+	HexDayArchive::recentDays.clear();
+	HexDayArchive::loadIndex();
+	return true;
+}
+
+bool HexDayArchive::refresh(void)
+{
+	QHash<QString, quint32> knownFiles;
+	
+	for (auto i = 0u; i < HexDayArchive::entries.size(); ++i)
+		knownFiles.insert(HexDayArchive::entries[i].filePath, i);
+	
+	std::vector<HexArchiveEntry> scannedEntries;
+	scannedEntries.reserve(HexDayArchive::entries.size());
+	
+	auto changed = false;
+	QDirIterator it(HexDayArchive::rootPath, { "*.txt", "*.hexd" }, QDir::Files, QDirIterator::Subdirectories);
+	
+	while (it.hasNext())
+	{
+		const QFileInfo info(it.next());
+		const auto known = knownFiles.constFind(info.absoluteFilePath());
+		
+		if (known != knownFiles.cend())
+		{
+			const auto& e = HexDayArchive::entries[known.value()];
+			
+			if (e.fileSize == info.size() and e.lastModified == info.lastModified().toMSecsSinceEpoch())
+			{
+				scannedEntries.push_back(e);
+				continue;
+			}
+			
+			HexDayArchive::evict(e.filePath);
+		}
+		else if (info.suffix() == "txt" and HexDayArchive::isIndexed(info.dir().absoluteFilePath(info.completeBaseName() + ".hexd"), knownFiles))
+			continue;
+		
+		HexArchiveEntry e;
+		
+		if (HexDayArchive::IndexFile(info, e))
+			scannedEntries.push_back(std::move(e));
+		
+		changed = true;
+	}
+	
+	std::sort(scannedEntries.begin(), scannedEntries.end(), [](const auto& a, const auto& b)
+	{
+		if (a.instrument != b.instrument)
+			return a.instrument < b.instrument;
+		
+		if (a.date != b.date)
+			return a.date < b.date;
+		
+		return a.filePath.endsWith(".hexd") and !b.filePath.endsWith(".hexd");
+	});
+	
+	const auto last = std::unique(scannedEntries.begin(), scannedEntries.end(), [](const auto& a, const auto& b) { return a.instrument == b.instrument and a.date == b.date; });
+	scannedEntries.erase(last, scannedEntries.end());
+	
+	changed = (changed or scannedEntries.size() != HexDayArchive::entries.size());
+	HexDayArchive::entries.swap(scannedEntries);
+	
+	if (changed)
+		HexDayArchive::saveIndex();
+	
+	return changed;
+}
+
+const QString& HexDayArchive::root(void) const
+{
+	return HexDayArchive::rootPath;
+}
+
+// The days of the other instruments with the same date, in archive order.
+std::vector<quint32> HexDayArchive::sameDate(quint32 index) const
+{
+	std::vector<quint32> indices;
+	
+	for (auto i = 0u; i < HexDayArchive::entries.size(); ++i)
+		if (i != index and HexDayArchive::entries[i].date == HexDayArchive::entries[index].date and HexDayArchive::entries[i].instrument != HexDayArchive::entries[index].instrument)
+			indices.push_back(i);
+	
+	return indices;
+}
+
+void HexDayArchive::saveIndex(void) const
+{
+	QFile indexFile(HexDayArchive::indexPath());
+	
+	if (!indexFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+		return;
+	
+	const QDir root(HexDayArchive::rootPath);
+	QDataStream stream(&indexFile);
+	stream << 0x48455849u << 2u << static_cast<quint32>(HexDayArchive::entries.size());
+	
+	for (const auto& e : HexDayArchive::entries)
+	{
+		stream << e.instrument << e.date << root.relativeFilePath(e.filePath) << e.fileSize << e.lastModified << e.numberOfCandlesticks;
+		
+		for (auto i = 0u; i < 4u; ++i)
+			stream << e.minima[i] << e.maxima[i];
+	}
+}
+
+quint32 HexDayArchive::size(void) const
+{
+	return static_cast<quint32>(HexDayArchive::entries.size());
+}
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef __HEX_EVENT_INDEX_HPP__
+#define __HEX_EVENT_INDEX_HPP__
+
+// Standard Libraries
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// A break or drop of the day: its candlestick, its second of the session, its level (D, W, M, Y breaks then drops)
+// and the side that won it (Buy, Sell, either, uncertainty).
+struct HexEvent
+{
+	std::uint32_t			index = 0u;
+	std::uint32_t			second = 0u;
+	std::uint8_t			level = 0u;
+	std::uint8_t			outcome = 0u;
+};
+
+// The events of a studied day in one array, sorted by level, outcome and time, with the offset of every level and
+// outcome pair. A pair is a contiguous slice and a time range within it two bisections, hence O(log n + k) queries.
+class HexEventIndex
+{
+	private:
+	
+		std::vector<HexEvent>			events;
+		std::array<std::uint32_t, 33u>		offsets = { };
+	
+	public:
+	
+		static constexpr std::uint32_t		Levels = 8u;
+		static constexpr std::uint32_t		Outcomes = 4u;
+		
+		inline std::span<const HexEvent>	bucket(std::uint32_t, std::uint32_t) const;
+		inline void				build(const std::vector<HexEvent>&);
+		inline void				clear(void);
+		inline std::span<const HexEvent>	range(std::uint32_t, std::uint32_t, std::uint32_t, std::uint32_t) const;
+		inline std::uint32_t			size(void) const;
+};
+
+std::span<const HexEvent> HexEventIndex::bucket(std::uint32_t level, std::uint32_t outcome) const
+{
+	const auto key = level*HexEventIndex::Outcomes + outcome;
+	return std::span<const HexEvent>(HexEventIndex::events.data() + HexEventIndex::offsets[key], HexEventIndex::offsets[key + 1u] - HexEventIndex::offsets[key]);
+}
+
+// Events come in time order, so a counting sort on the pair keeps them sorted by time within it.
+void HexEventIndex::build(const std::vector<HexEvent>& timeOrdered)
+{
+	HexEventIndex::offsets.fill(0u);
+	
+	for (const auto& event : timeOrdered)
+		++HexEventIndex::offsets[event.level*HexEventIndex::Outcomes + event.outcome + 1u];
+	
+	for (auto key = 1u; key < HexEventIndex::offsets.size(); ++key)
+		HexEventIndex::offsets[key] += HexEventIndex::offsets[key - 1u];
+	
+	auto next = HexEventIndex::offsets;
+	HexEventIndex::events.resize(timeOrdered.size());
+	
+	for (const auto& event : timeOrdered)
+		HexEventIndex::events[next[event.level*HexEventIndex::Outcomes + event.outcome]++] = event;
+}
+
+void HexEventIndex::clear(void)
+{
+	HexEventIndex::events.clear();
+	HexEventIndex::offsets.fill(0u);
+}
+
+// The events of that level and outcome from the first second up to, but excluding, the last one.
+std::span<const HexEvent> HexEventIndex::range(std::uint32_t level, std::uint32_t outcome, std::uint32_t firstSecond, std::uint32_t lastSecond) const
+{
+	const auto slice = HexEventIndex::bucket(level, outcome);
+	const auto first = std::partition_point(slice.begin(), slice.end(), [firstSecond](const HexEvent& e) { return e.second < firstSecond; });
+	const auto last = std::partition_point(first, slice.end(), [lastSecond](const HexEvent& e) { return e.second < lastSecond; });
+	return std::span<const HexEvent>(first, last);
+}
+
+std::uint32_t HexEventIndex::size(void) const
+{
+	return static_cast<std::uint32_t>(HexEventIndex::events.size());
+}
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef __HEX_EXTREMUM_TABLE_HPP__
+#define __HEX_EXTREMUM_TABLE_HPP__
+
+// Standard Libraries
+#include <algorithm>
+#include <bit>
+#include <vector>
+
+// Personal Libraries
+#include "HexCoreTypes.hpp"
+
+// Sparse tables over the candlesticks: level k holds the max high (min low) of every window of 2^k candlesticks.
+// Both queries below jump forward over whole windows that cannot contain the limit, hence O(log n) each.
+class HexExtremumTable
+{
+	private:
+	
+		std::vector<double>			maxHighs;
+		std::vector<double>			minLows;
+		
+		std::uint32_t				levels = 0u;
+		std::uint32_t				size = 0u;
+	
+	public:
+	
+		inline void				build(const std::vector<double>&, const std::vector<double>&);
+		inline void				clear(void);
+		inline std::uint32_t			firstHighAtLeast(std::uint32_t, double) const;
+		inline std::uint32_t			firstLowAtMost(std::uint32_t, double) const;
+		inline std::uint32_t			numberOfCandlesticks(void) const;
+};
+
+void HexExtremumTable::build(const std::vector<double>& lows, const std::vector<double>& highs)
+{
+	HexExtremumTable::size = static_cast<std::uint32_t>(lows.size());
+	HexExtremumTable::levels = static_cast<std::uint32_t>(std::bit_width(HexExtremumTable::size));
+	
+	HexExtremumTable::maxHighs.resize(HexExtremumTable::levels*HexExtremumTable::size);
+	HexExtremumTable::minLows.resize(HexExtremumTable::levels*HexExtremumTable::size);
+	
+	std::copy(highs.cbegin(), highs.cend(), HexExtremumTable::maxHighs.begin());
+	std::copy(lows.cbegin(), lows.cend(), HexExtremumTable::minLows.begin());
+	
+	for (auto k = 1u; k < HexExtremumTable::levels; ++k)
+	{
+		const auto half = 1u << (k - 1u);
+		const auto previous = (k - 1u)*HexExtremumTable::size;
+		const auto current = k*HexExtremumTable::size;
+		
+		for (auto i = 0u; i + 2u*half <= HexExtremumTable::size; ++i)
+		{
+			HexExtremumTable::maxHighs[current + i] = std::max(HexExtremumTable::maxHighs[previous + i], HexExtremumTable::maxHighs[previous + i + half]);
+			HexExtremumTable::minLows[current + i] = std::min(HexExtremumTable::minLows[previous + i], HexExtremumTable::minLows[previous + i + half]);
+		}
+	}
+}
+
+void HexExtremumTable::clear(void)
+{
+	HexExtremumTable::maxHighs.clear();
+	HexExtremumTable::minLows.clear();
+	HexExtremumTable::levels = 0u;
+	HexExtremumTable::size = 0u;
+}
+
+// Returns the first index >= start whose high is >= limit, or the number of candlesticks if there is none.
+std::uint32_t HexExtremumTable::firstHighAtLeast(std::uint32_t start, double limit) const
+{
+	auto position = start;
+	
+	for (auto k = HexExtremumTable::levels; k-- > 0u;)
+	{
+		const auto span = 1u << k;
+		
+		if (position + span <= HexExtremumTable::size and HexExtremumTable::maxHighs[k*HexExtremumTable::size + position] < limit)
+			position += span;
+	}
+	
+	return position;
+}
+
+// Returns the first index >= start whose low is <= limit, or the number of candlesticks if there is none.
+std::uint32_t HexExtremumTable::firstLowAtMost(std::uint32_t start, double limit) const
+{
+	auto position = start;
+	
+	for (auto k = HexExtremumTable::levels; k-- > 0u;)
+	{
+		const auto span = 1u << k;
+		
+		if (position + span <= HexExtremumTable::size and limit < HexExtremumTable::minLows[k*HexExtremumTable::size + position])
+			position += span;
+	}
+	
+	return position;
+}
+
+std::uint32_t HexExtremumTable::numberOfCandlesticks(void) const
+{
+	return HexExtremumTable::size;
+}
+
+#endif
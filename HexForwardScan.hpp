@@ -0,0 +1,115 @@
+#ifndef __HEX_FORWARD_SCAN_HPP__
+#define __HEX_FORWARD_SCAN_HPP__
+
+// Standard Libraries
+#include <bit>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) or defined(__i386__)
+#include <immintrin.h>
+#define HEX_X86_KERNELS
+#endif
+
+// Personal Libraries
+#include "HexCoreTypes.hpp"
+
+// Finds the first candlestick of [start, end) whose low is <= lower or whose high is >= upper, or end if there is
+// none. The kernel is picked once at runtime from the CPU features: AVX-512, AVX2 or the portable scalar loop. Every
+// kernel stays callable, so each one the CPU runs can be checked against the scalar loop.
+class HexForwardScan
+{
+	public:
+	
+		typedef std::uint32_t			(*Kernel)(const double*, const double*, std::uint32_t, std::uint32_t, double, double);
+		
+#ifdef HEX_X86_KERNELS
+		__attribute__((target("avx2")))
+		inline static std::uint32_t		Avx2FirstCrossing(const double*, const double*, std::uint32_t, std::uint32_t, double, double);
+		__attribute__((target("avx512f")))
+		inline static std::uint32_t		Avx512FirstCrossing(const double*, const double*, std::uint32_t, std::uint32_t, double, double);
+#endif
+		inline static std::uint32_t		FirstCrossing(const double*, const double*, std::uint32_t, std::uint32_t, double, double);
+		inline static const char*		KernelName(void);
+		inline static std::vector<std::pair<const char*, Kernel>>	Kernels(void);
+		inline static std::uint32_t		ScalarFirstCrossing(const double*, const double*, std::uint32_t, std::uint32_t, double, double);
+};
+
+#ifdef HEX_X86_KERNELS
+std::uint32_t HexForwardScan::Avx2FirstCrossing(const double* lows, const double* highs, std::uint32_t start, std::uint32_t end, double lower, double upper)
+{
+	const auto lowerLimits = _mm256_set1_pd(lower);
+	const auto upperLimits = _mm256_set1_pd(upper);
+	auto i = start;
+	
+	for (; i + 4u <= end; i += 4u)
+	{
+		const auto lowHits = _mm256_cmp_pd(_mm256_loadu_pd(lows + i), lowerLimits, _CMP_LE_OQ);
+		const auto highHits = _mm256_cmp_pd(_mm256_loadu_pd(highs + i), upperLimits, _CMP_GE_OQ);
+		const auto mask = static_cast<std::uint32_t>(_mm256_movemask_pd(_mm256_or_pd(lowHits, highHits)));
+		
+		if (mask != 0u)
+			return i + static_cast<std::uint32_t>(std::countr_zero(mask));
+	}
+	
+	return HexForwardScan::ScalarFirstCrossing(lows, highs, i, end, lower, upper);
+}
+
+std::uint32_t HexForwardScan::Avx512FirstCrossing(const double* lows, const double* highs, std::uint32_t start, std::uint32_t end, double lower, double upper)
+{
+	const auto lowerLimits = _mm512_set1_pd(lower);
+	const auto upperLimits = _mm512_set1_pd(upper);
+	auto i = start;
+	
+	for (; i + 8u <= end; i += 8u)
+	{
+		const auto lowHits = _mm512_cmp_pd_mask(_mm512_loadu_pd(lows + i), lowerLimits, _CMP_LE_OQ);
+		const auto highHits = _mm512_cmp_pd_mask(_mm512_loadu_pd(highs + i), upperLimits, _CMP_GE_OQ);
+		const auto mask = static_cast<std::uint32_t>(lowHits | highHits);
+		
+		if (mask != 0u)
+			return i + static_cast<std::uint32_t>(std::countr_zero(mask));
+	}
+	
+	return HexForwardScan::ScalarFirstCrossing(lows, highs, i, end, lower, upper);
+}
+#endif
+
+std::uint32_t HexForwardScan::FirstCrossing(const double* lows, const double* highs, std::uint32_t start, std::uint32_t end, double lower, double upper)
+{
+	static const auto kernel = HexForwardScan::Kernels().back().second;
+	return kernel(lows, highs, start, end, lower, upper);
+}
+
+const char* HexForwardScan::KernelName(void)
+{
+	return HexForwardScan::Kernels().back().first;
+}
+
+// Every kernel the CPU runs, the portable one first and the one FirstCrossing picks last.
+std::vector<std::pair<const char*, HexForwardScan::Kernel>> HexForwardScan::Kernels(void)
+{
+	std::vector<std::pair<const char*, Kernel>> kernels = { { "scalar", &HexForwardScan::ScalarFirstCrossing } };
+#ifdef HEX_X86_KERNELS
+	__builtin_cpu_init();
+	
+	if (__builtin_cpu_supports("avx2"))
+		kernels.emplace_back("AVX2", &HexForwardScan::Avx2FirstCrossing);
+	
+	if (__builtin_cpu_supports("avx512f"))
+		kernels.emplace_back("AVX-512", &HexForwardScan::Avx512FirstCrossing);
+#endif
+	return kernels;
+}
+
+// The portable kernel, which the vector kernels are checked against.
+std::uint32_t HexForwardScan::ScalarFirstCrossing(const double* lows, const double* highs, std::uint32_t start, std::uint32_t end, double lower, double upper)
+{
+	for (auto i = start; i < end; ++i)
+		if (lows[i] <= lower or highs[i] >= upper)
+			return i;
+	
+	return end;
+}
+
+#endif
@@ -0,0 +1,337 @@
+#ifndef __HEX_PARAMETER_SWEEP_HPP__
+#define __HEX_PARAMETER_SWEEP_HPP__
+
+// Qt Libraries
+#include <QDir>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QTextStream>
+
+// Standard Libraries
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+// Personal Libraries
+#include "HexBinaryDay.hpp"
+#include "HexDayAnalysis.hpp"
+#include "HexTextParser.hpp"
+
+// The break and drop statistics of many days for every TP and SL pair. Days are spread over threads that each reduce
+// their own share, per level, per half hour and as the spread between days, and the shares are added up at the end.
+class HexParameterSweep
+{
+	private:
+	
+		inline static std::vector<QString>	DayFiles(const QString&);
+		inline static QString			HalfHour(quint32);
+		inline static bool			LoadDay(const QString&, HexDayAnalysis&);
+		
+		std::vector<QString>			filePaths;
+		std::vector<QString>			failedFiles;
+		std::vector<HexSweepCell>		cells;
+		std::vector<HexLevelStatistics>		statistics;
+		std::vector<std::vector<HexSweepCell>>	dayCells;
+		bool					keepDays;
+	
+	public:
+	
+		inline					HexParameterSweep(const QString&, const std::vector<qreal>&, const std::vector<qreal>&, bool);
+		inline					HexParameterSweep(const std::vector<QString>&, const std::vector<qreal>&, const std::vector<qreal>&, bool);
+		
+		inline const std::vector<QString>&	failures(void) const;
+		inline quint32				numberOfDays(void) const;
+		inline void				run(quint32);
+		inline void				write(QTextStream&) const;
+		inline void				writeJson(QTextStream&) const;
+};
+
+HexParameterSweep::HexParameterSweep(const QString& directory, const std::vector<qreal>& takeProfits, const std::vector<qreal>& stopLosses, bool days) :
+	HexParameterSweep(HexParameterSweep::DayFiles(directory), takeProfits, stopLosses, days)
+{
+}
+
+HexParameterSweep::HexParameterSweep(const std::vector<QString>& files, const std::vector<qreal>& takeProfits, const std::vector<qreal>& stopLosses, bool days) : filePaths(files), keepDays(days)
+{
+	HexParameterSweep::cells.reserve(takeProfits.size()*stopLosses.size());
+	
+	for (const auto& tp : takeProfits)
+		for (const auto& sl : stopLosses)
+			HexParameterSweep::cells.emplace_back(tp, sl);
+	
+	HexParameterSweep::statistics.resize(HexParameterSweep::cells.size());
+}
+
+// The binary days of a directory, or its text days when it has no binary one.
+std::vector<QString> HexParameterSweep::DayFiles(const QString& directory)
+{
+	const QDir dir(directory);
+	auto fileNames = dir.entryList({ "*.hexd" }, QDir::Files, QDir::Name);
+	
+	if (fileNames.isEmpty())
+		fileNames = dir.entryList({ "*.txt" }, QDir::Files, QDir::Name);
+	
+	std::vector<QString> files;
+	
+	for (const auto& fileName : fileNames)
+		files.push_back(dir.filePath(fileName));
+	
+	return files;
+}
+
+const std::vector<QString>& HexParameterSweep::failures(void) const
+{
+	return HexParameterSweep::failedFiles;
+}
+
+// The local start time of a half hour of the session, as in the break and drop report.
+QString HexParameterSweep::HalfHour(quint32 index)
+{
+	const auto hour = 15u + (index + 1u)/2u;
+	const auto minute = (index % 2u == 0u ? "30" : "00");
+	return QString::number(hour) + ':' + minute;
+}
+
+bool HexParameterSweep::LoadDay(const QString& filePath, HexDayAnalysis& analysis)
+{
+	if (filePath.endsWith(".hexd"))
+		return HexBinaryDay::Load(filePath, analysis);
+	
+	return HexTextParser::Parse(filePath, analysis).error == HexParseReport::None;
+}
+
+quint32 HexParameterSweep::numberOfDays(void) const
+{
+	return static_cast<quint32>(HexParameterSweep::filePaths.size());
+}
+
+void HexParameterSweep::run(quint32 numberOfThreads)
+{
+	const auto numberOfFiles = static_cast<quint32>(HexParameterSweep::filePaths.size());
+	const auto numberOfCells = static_cast<quint32>(HexParameterSweep::cells.size());
+	
+	if (HexParameterSweep::keepDays)
+		HexParameterSweep::dayCells.assign(numberOfFiles, HexParameterSweep::cells);
+	
+	std::vector<std::vector<HexSweepCell>> partialCells(numberOfThreads, HexParameterSweep::cells);
+	std::vector<std::vector<HexLevelStatistics>> partialStatistics(numberOfThreads, HexParameterSweep::statistics);
+	std::vector<char> failed(numberOfFiles, 0);
+	std::atomic<quint32> nextFile = 0u;
+	
+	{
+		std::vector<std::jthread> workers;
+		workers.reserve(numberOfThreads);
+		
+		for (auto t = 0u; t < numberOfThreads; ++t)
+		{
+			workers.emplace_back([&, t](void)
+			{
+				HexDayAnalysis analysis;
+				
+				for (auto f = nextFile++; f < numberOfFiles; f = nextFile++)
+				{
+					if (!HexParameterSweep::LoadDay(HexParameterSweep::filePaths[f], analysis))
+					{
+						failed[f] = 1;
+						continue;
+					}
+					
+					for (auto c = 0u; c < numberOfCells; ++c)
+					{
+						auto& partial = partialCells[t][c];
+						auto& partialStatistic = partialStatistics[t][c];
+						const auto tallies = analysis.tallyBreaksAndDrops(partial.takeProfit, partial.stopLoss);
+						
+						for (auto l = 0u; l < 8u; ++l)
+						{
+							HexLevelTally day;
+							
+							for (auto h = 0u; h < 13u; ++h)
+							{
+								day += tallies[l][h];
+								partialStatistic.halfHours[l][h] += tallies[l][h];
+							}
+							
+							partial.levels[l] += day;
+							partialStatistic.spreads[l].add(day, partial.takeProfit, partial.stopLoss);
+							
+							if (HexParameterSweep::keepDays)
+								HexParameterSweep::dayCells[f][c].levels[l] = day;
+						}
+					}
+				}
+			});
+		}
+	}
+	
+	for (auto t = 0u; t < numberOfThreads; ++t)
+	{
+		for (auto c = 0u; c < numberOfCells; ++c)
+		{
+			for (auto l = 0u; l < 8u; ++l)
+				HexParameterSweep::cells[c].levels[l] += partialCells[t][c].levels[l];
+			
+			HexParameterSweep::statistics[c] += partialStatistics[t][c];
+		}
+	}
+	
+	for (auto f = 0u; f < numberOfFiles; ++f)
+		if (failed[f] != 0)
+			HexParameterSweep::failedFiles.push_back(HexParameterSweep::filePaths[f]);
+}
+
+// Rows of the whole session, then for the summary the rows of every half hour. Only the summary rows of the whole
+// session have margins, the half width of the 95% interval of their expectations; they are left empty elsewhere. The
+// last columns count the outcome letters the four classes are made of.
+void HexParameterSweep::write(QTextStream& stream) const
+{
+	static const std::array<char, 8u> levelCodes = { 'D', 'W', 'M', 'Y', 'd', 'w', 'm', 'y' };
+	
+	const auto margin = [](double value)
+	{
+		return (std::isnan(value) ? QString() : QString::number(value, 'f', 2));
+	};
+	
+	const auto writeTally = [&](const QString& day, const HexSweepCell& cell, quint32 level, const QString& time, const HexLevelTally& tally, const HexLevelSpread* spread)
+	{
+		if (tally.occurrences() == 0u)
+			return;
+		
+		stream << day << ',' << cell.takeProfit << ',' << cell.stopLoss << ',' << levelCodes[level] << ',' << time << ',' << tally.occurrences()
+			<< ',' << QString::number(tally.ratio(0u), 'f', 2) << ',' << QString::number(tally.ratio(1u), 'f', 2)
+			<< ',' << QString::number(tally.ratio(2u), 'f', 2) << ',' << QString::number(tally.ratio(3u), 'f', 2)
+			<< ',' << QString::number(tally.buyExpectation(cell.takeProfit, cell.stopLoss), 'f', 2)
+			<< ',' << QString::number(tally.sellExpectation(cell.takeProfit, cell.stopLoss), 'f', 2)
+			<< ',' << (spread != nullptr ? margin(spread->margin(tally, cell.takeProfit, cell.stopLoss, 0u)) : QString())
+			<< ',' << (spread != nullptr ? margin(spread->margin(tally, cell.takeProfit, cell.stopLoss, 1u)) : QString());
+		
+		for (const auto letter : tally.letters)
+			stream << ',' << letter;
+		
+		stream << '\n';
+	};
+	
+	stream << "day,tp,sl,level,time,occurrences,buy,sell,either,uncertainty,buyExpectation,sellExpectation,buyMargin,sellMargin,b,s,u,B,S,e\n";
+	
+	for (auto c = 0u; c < HexParameterSweep::cells.size(); ++c)
+	{
+		const auto& cell = HexParameterSweep::cells[c];
+		const auto& statistic = HexParameterSweep::statistics[c];
+		
+		for (auto l = 0u; l < 8u; ++l)
+		{
+			writeTally("all", cell, l, "all", cell.levels[l], &statistic.spreads[l]);
+			
+			for (auto h = 0u; h < 13u; ++h)
+				writeTally("all", cell, l, HexParameterSweep::HalfHour(h), statistic.halfHours[l][h], nullptr);
+		}
+	}
+	
+	for (auto f = 0u; f < HexParameterSweep::dayCells.size(); ++f)
+		for (const auto& cell : HexParameterSweep::dayCells[f])
+			for (auto l = 0u; l < 8u; ++l)
+				writeTally(HexParameterSweep::filePaths[f].split('/').back(), cell, l, "all", cell.levels[l], nullptr);
+}
+
+// Same content as write(), as one document: the summary of every cell and, with kept days, the days that loaded.
+// Margins that need more days are null.
+void HexParameterSweep::writeJson(QTextStream& stream) const
+{
+	static const std::array<const char*, 8u> levelCodes = { "D", "W", "M", "Y", "d", "w", "m", "y" };
+	static const std::array<const char*, 6u> letterCodes = { "b", "s", "u", "B", "S", "e" };
+	
+	const auto tallyOf = [](const HexSweepCell& cell, const HexLevelTally& tally)
+	{
+		QJsonObject letters;
+		
+		for (auto i = 0u; i < 6u; ++i)
+			letters.insert(letterCodes[i], static_cast<qint64>(tally.letters[i]));
+		
+		return QJsonObject { { "occurrences", static_cast<qint64>(tally.occurrences()) }, { "letters", letters },
+					{ "buy", tally.ratio(0u) }, { "sell", tally.ratio(1u) }, { "either", tally.ratio(2u) }, { "uncertainty", tally.ratio(3u) },
+					{ "buyExpectation", tally.buyExpectation(cell.takeProfit, cell.stopLoss) },
+					{ "sellExpectation", tally.sellExpectation(cell.takeProfit, cell.stopLoss) } };
+	};
+	
+	const auto margin = [](double value)
+	{
+		return (std::isnan(value) ? QJsonValue() : QJsonValue(value));
+	};
+	
+	// With statistics, the summary levels also carry their margins and their half hours.
+	const auto levelsOf = [&](const HexSweepCell& cell, const HexLevelStatistics* statistic)
+	{
+		QJsonArray levels;
+		
+		for (auto l = 0u; l < 8u; ++l)
+		{
+			const auto& tally = cell.levels[l];
+			
+			if (tally.occurrences() == 0u)
+				continue;
+			
+			auto level = tallyOf(cell, tally);
+			level.insert("level", levelCodes[l]);
+			
+			if (statistic != nullptr)
+			{
+				QJsonArray halfHours;
+				
+				for (auto h = 0u; h < 13u; ++h)
+				{
+					if (statistic->halfHours[l][h].occurrences() == 0u)
+						continue;
+					
+					auto halfHour = tallyOf(cell, statistic->halfHours[l][h]);
+					halfHour.insert("time", HexParameterSweep::HalfHour(h));
+					halfHours.append(halfHour);
+				}
+				
+				level.insert("buyMargin", margin(statistic->spreads[l].margin(tally, cell.takeProfit, cell.stopLoss, 0u)));
+				level.insert("sellMargin", margin(statistic->spreads[l].margin(tally, cell.takeProfit, cell.stopLoss, 1u)));
+				level.insert("halfHours", halfHours);
+			}
+			
+			levels.append(level);
+		}
+		
+		return levels;
+	};
+	
+	QJsonArray cellArray;
+	
+	for (auto c = 0u; c < HexParameterSweep::cells.size(); ++c)
+	{
+		const auto& cell = HexParameterSweep::cells[c];
+		QJsonArray days;
+		
+		for (auto f = 0u; f < HexParameterSweep::dayCells.size(); ++f)
+		{
+			const auto& filePath = HexParameterSweep::filePaths[f];
+			
+			if (std::find(HexParameterSweep::failedFiles.cbegin(), HexParameterSweep::failedFiles.cend(), filePath) == HexParameterSweep::failedFiles.cend())
+				days.append(QJsonObject { { "day", filePath.split('/').back() }, { "levels", levelsOf(HexParameterSweep::dayCells[f][c], nullptr) } });
+		}
+		
+		QJsonObject cellObject { { "tp", cell.takeProfit }, { "sl", cell.stopLoss }, { "levels", levelsOf(cell, &HexParameterSweep::statistics[c]) } };
+		
+		if (HexParameterSweep::keepDays)
+			cellObject.insert("days", days);
+		
+		cellArray.append(cellObject);
+	}
+	
+	QJsonArray failedArray;
+	
+	for (const auto& filePath : HexParameterSweep::failedFiles)
+		failedArray.append(filePath);
+	
+	const auto numberOfDays = static_cast<qint64>(HexParameterSweep::filePaths.size() - HexParameterSweep::failedFiles.size());
+	stream << QJsonDocument(QJsonObject { { "days", numberOfDays }, { "failures", failedArray }, { "cells", cellArray } }).toJson();
+}
+
+#endif
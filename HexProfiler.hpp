@@ -0,0 +1,234 @@
+#ifndef __HEX_PROFILER_HPP__
+#define __HEX_PROFILER_HPP__
+
+// Standard Libraries
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Personal Libraries
+#include "HexCoreTypes.hpp"
+
+// HEX_PROFILE_SCOPE("name") times the rest of the enclosing block. Without HEX_PROFILING it expands to nothing, so
+// the hot paths carry no timer at all in a regular build.
+#ifdef HEX_PROFILING
+#define HEX_PROFILE_JOIN_IMPL(a, b) a##b
+#define HEX_PROFILE_JOIN(a, b) HEX_PROFILE_JOIN_IMPL(a, b)
+#define HEX_PROFILE_SCOPE(name) const HexScopedTimer HEX_PROFILE_JOIN(hexScopedTimer, __LINE__)(name)
+#else
+#define HEX_PROFILE_SCOPE(name)
+#endif
+
+struct HexProfileEvent
+{
+	const char*			name = nullptr;
+	std::uint64_t			start = 0u;
+	std::uint64_t			duration = 0u;
+	std::uint32_t			frame = 0u;
+	std::uint32_t			thread = 0u;
+};
+
+struct HexProfileSummary
+{
+	const char*			name = nullptr;
+	double				lastFrame = 0.;
+	HexLatencySamples		samples;
+};
+
+// One slot of the ring. The sequence is zero while a writer fills it and the event number plus one afterwards, so
+// a reader that sees the same number before and after copying the fields got a whole event.
+struct HexProfileSlot
+{
+	std::atomic<const char*>	name = nullptr;
+	std::atomic<std::uint64_t>	start = 0u;
+	std::atomic<std::uint64_t>	duration = 0u;
+	std::atomic<std::uint32_t>	frame = 0u;
+	std::atomic<std::uint32_t>	thread = 0u;
+	std::atomic<std::uint64_t>	sequence = 0u;
+};
+
+// Timed events of every thread in a fixed ring that writers claim with one fetch_add and never wait on. A frame ends
+// with each paint of the chart, so the events recorded since the previous paint make up its breakdown; times are in
+// nanoseconds since the first use.
+class HexProfiler
+{
+	private:
+	
+		static constexpr std::uint64_t		Capacity = 16'384u;
+		
+		inline static std::array<HexProfileSlot, Capacity>	slots;
+		inline static std::atomic<std::uint64_t>	head = 0u;
+		inline static std::atomic<std::uint32_t>	frame = 0u;
+		inline static std::atomic<std::uint32_t>	numberOfThreads = 0u;
+		
+		inline static std::uint32_t		ThreadIndex(void);
+	
+	public:
+	
+#ifdef HEX_PROFILING
+		static constexpr bool			Enabled = true;
+#else
+		static constexpr bool			Enabled = false;
+#endif
+		
+		inline static std::uint32_t		CurrentFrame(void);
+		inline static void			EndFrame(void);
+		inline static std::uint64_t		Now(void);
+		inline static void			Record(const char*, std::uint64_t, std::uint64_t);
+		inline static std::vector<HexProfileEvent>	Snapshot(void);
+		inline static std::vector<HexProfileSummary>	Summarize(void);
+		inline static std::string		TraceJson(void);
+};
+
+class HexScopedTimer
+{
+	private:
+	
+		const char*				name;
+		std::uint64_t				start;
+	
+	public:
+	
+		inline explicit				HexScopedTimer(const char*);
+		inline					~HexScopedTimer(void);
+};
+
+std::uint32_t HexProfiler::CurrentFrame(void)
+{
+	return HexProfiler::frame.load(std::memory_order_relaxed);
+}
+
+void HexProfiler::EndFrame(void)
+{
+	HexProfiler::frame.fetch_add(1u, std::memory_order_relaxed);
+}
+
+std::uint64_t HexProfiler::Now(void)
+{
+	static const auto epoch = std::chrono::steady_clock::now();
+	return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+}
+
+void HexProfiler::Record(const char* name, std::uint64_t start, std::uint64_t end)
+{
+	const auto index = HexProfiler::head.fetch_add(1u, std::memory_order_relaxed);
+	auto& slot = HexProfiler::slots[index % HexProfiler::Capacity];
+	
+	slot.sequence.store(0u, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	
+	slot.name.store(name, std::memory_order_relaxed);
+	slot.start.store(start, std::memory_order_relaxed);
+	slot.duration.store(end - start, std::memory_order_relaxed);
+	slot.frame.store(HexProfiler::frame.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	slot.thread.store(HexProfiler::ThreadIndex(), std::memory_order_relaxed);
+	slot.sequence.store(index + 1u, std::memory_order_release);
+}
+
+// The events still in the ring, oldest first. Those being written or already overwritten are skipped.
+std::vector<HexProfileEvent> HexProfiler::Snapshot(void)
+{
+	const auto end = HexProfiler::head.load(std::memory_order_acquire);
+	const auto begin = (end > HexProfiler::Capacity ? end - HexProfiler::Capacity : 0u);
+	
+	std::vector<HexProfileEvent> events;
+	events.reserve(end - begin);
+	
+	for (auto index = begin; index < end; ++index)
+	{
+		const auto& slot = HexProfiler::slots[index % HexProfiler::Capacity];
+		
+		if (slot.sequence.load(std::memory_order_acquire) != index + 1u)
+			continue;
+		
+		HexProfileEvent event;
+		event.name = slot.name.load(std::memory_order_relaxed);
+		event.start = slot.start.load(std::memory_order_relaxed);
+		event.duration = slot.duration.load(std::memory_order_relaxed);
+		event.frame = slot.frame.load(std::memory_order_relaxed);
+		event.thread = slot.thread.load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_acquire);
+		
+		if (slot.sequence.load(std::memory_order_relaxed) == index + 1u)
+			events.push_back(event);
+	}
+	
+	return events;
+}
+
+// Per timer, sorted by name: the milliseconds spent in the last completed frame and the durations of every event
+// still in the ring, for the rolling percentiles.
+std::vector<HexProfileSummary> HexProfiler::Summarize(void)
+{
+	const auto lastFrame = HexProfiler::CurrentFrame() - 1u;
+	std::vector<HexProfileSummary> summaries;
+	
+	for (const auto& event : HexProfiler::Snapshot())
+	{
+		auto summary = std::find_if(summaries.begin(), summaries.end(), [&event](const HexProfileSummary& s) { return std::string_view(s.name) == event.name; });
+		
+		if (summary == summaries.end())
+		{
+			summaries.emplace_back();
+			summary = summaries.end() - 1;
+			summary->name = event.name;
+		}
+		
+		summary->samples.add(static_cast<double>(event.duration)/1'000.);
+		
+		if (event.frame == lastFrame)
+			summary->lastFrame += static_cast<double>(event.duration)/1'000'000.;
+	}
+	
+	std::sort(summaries.begin(), summaries.end(), [](const HexProfileSummary& a, const HexProfileSummary& b) { return std::string_view(a.name) < b.name; });
+	return summaries;
+}
+
+std::uint32_t HexProfiler::ThreadIndex(void)
+{
+	thread_local const auto index = HexProfiler::numberOfThreads.fetch_add(1u, std::memory_order_relaxed);
+	return index;
+}
+
+// Complete events of the Chrome trace event format, in microseconds, which chrome://tracing and Perfetto open.
+std::string HexProfiler::TraceJson(void)
+{
+	const auto number = [](double value)
+	{
+		char buffer[32];
+		const auto end = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::fixed, 3).ptr;
+		return std::string(buffer, end);
+	};
+	
+	std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	auto first = true;
+	
+	for (const auto& event : HexProfiler::Snapshot())
+	{
+		json += (first ? "\n" : ",\n");
+		json += "{\"name\":\"" + std::string(event.name) + "\",\"ph\":\"X\",\"pid\":1,\"tid\":" + std::to_string(event.thread);
+		json += ",\"ts\":" + number(static_cast<double>(event.start)/1'000.) + ",\"dur\":" + number(static_cast<double>(event.duration)/1'000.);
+		json += ",\"args\":{\"frame\":" + std::to_string(event.frame) + "}}";
+		first = false;
+	}
+	
+	json += "\n]}\n";
+	return json;
+}
+
+HexScopedTimer::HexScopedTimer(const char* timerName) : name(timerName), start(HexProfiler::Now())
+{
+}
+
+HexScopedTimer::~HexScopedTimer(void)
+{
+	HexProfiler::Record(HexScopedTimer::name, HexScopedTimer::start, HexProfiler::Now());
+}
+
+#endif
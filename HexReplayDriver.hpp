@@ -0,0 +1,142 @@
+#ifndef __HEX_REPLAY_DRIVER_HPP__
+#define __HEX_REPLAY_DRIVER_HPP__
+
+// Qt Libraries
+#include <QString>
+
+// Standard Libraries
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Personal Libraries
+#include "HexBinaryDay.hpp"
+#include "HexDayAnalysis.hpp"
+#include "HexTextParser.hpp"
+
+// Replays a day file through the streaming path the way a live session runs it. A feeder thread releases the
+// candlesticks at a multiple of wall-clock speed, or as fast as it can, and the calling thread appends whatever has
+// arrived, then extracts the newest strips once, as the chart does after each job. Every candlestick is timed from
+// its arrival until its study is up to date, which includes the outcomes it resolves, and until the strips show it.
+class HexReplayDriver
+{
+	private:
+	
+		typedef std::chrono::steady_clock	Clock;
+		
+		HexColumns				day;
+		std::vector<std::pair<quint32, Clock::time_point>>	arrivals;
+		std::mutex				arrivalMutex;
+		std::condition_variable			arrivalCondition;
+		bool					fed = false;
+		
+		inline void				feed(qreal, quint32);
+	
+	public:
+	
+		inline bool				load(const QString&);
+		inline HexReplayReport			run(qreal, quint32, quint32, quint32, qreal, qreal);
+		inline quint32				size(void) const;
+};
+
+// Candlestick i is due i/speed seconds after the start, so a late wake-up releases the overdue ones at once instead
+// of drifting. A speed of zero releases them all without waiting.
+void HexReplayDriver::feed(qreal speed, quint32 count)
+{
+	const auto start = Clock::now();
+	
+	for (auto i = 0u; i < count; ++i)
+	{
+		if (speed > 0.)
+			std::this_thread::sleep_until(start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<qreal>(i/speed)));
+		
+		{
+			const std::lock_guard lock(HexReplayDriver::arrivalMutex);
+			HexReplayDriver::arrivals.emplace_back(i, Clock::now());
+		}
+		
+		HexReplayDriver::arrivalCondition.notify_one();
+	}
+	
+	{
+		const std::lock_guard lock(HexReplayDriver::arrivalMutex);
+		HexReplayDriver::fed = true;
+	}
+	
+	HexReplayDriver::arrivalCondition.notify_one();
+}
+
+bool HexReplayDriver::load(const QString& filePath)
+{
+	HexReplayDriver::day = HexColumns();
+	
+	if (filePath.endsWith(".hexd"))
+		return HexBinaryDay::Load(filePath, HexReplayDriver::day);
+	
+	return HexTextParser::Parse(filePath, HexReplayDriver::day).error == HexParseReport::None;
+}
+
+// Replays the first count candlesticks of the loaded day, or all of them for a count of zero, into a fresh
+// analysis. The throughput is the number of candlesticks over the time until the last strips were extracted.
+HexReplayReport HexReplayDriver::run(qreal speed, quint32 count, quint32 numberOfCandlesticks, quint32 timeUnit, qreal tp, qreal sl)
+{
+	HexReplayReport report;
+	HexDayAnalysis analysis;
+	
+	const auto& [dMin, wMin, mMin, yMin] = HexReplayDriver::day.minima;
+	const auto& [dMax, wMax, mMax, yMax] = HexReplayDriver::day.maxima;
+	analysis.setMinima(dMin, wMin, mMin, yMin);
+	analysis.setMaxima(dMax, wMax, mMax, yMax);
+	
+	const auto microsecondsSince = [](Clock::time_point time) { return std::chrono::duration<qreal, std::micro>(Clock::now() - time).count(); };
+	
+	HexReplayDriver::arrivals.clear();
+	HexReplayDriver::fed = false;
+	
+	std::vector<std::pair<quint32, Clock::time_point>> batch;
+	const auto start = Clock::now();
+	std::thread feeder(&HexReplayDriver::feed, this, speed, (count == 0u ? HexReplayDriver::size() : std::min(count, HexReplayDriver::size())));
+	
+	while (true)
+	{
+		{
+			std::unique_lock lock(HexReplayDriver::arrivalMutex);
+			HexReplayDriver::arrivalCondition.wait(lock, [this](void) { return !HexReplayDriver::arrivals.empty() or HexReplayDriver::fed; });
+			
+			if (HexReplayDriver::arrivals.empty())
+				break;
+			
+			batch.swap(HexReplayDriver::arrivals);
+		}
+		
+		for (const auto& [index, arrival] : batch)
+		{
+			analysis.appendCandlestick(HexReplayDriver::day.lows[index], HexReplayDriver::day.highs[index]);
+			report.studyLatency.add(microsecondsSince(arrival));
+		}
+		
+		analysis.extractLiveSample(numberOfCandlesticks, timeUnit, tp, sl);
+		
+		for (const auto& [index, arrival] : batch)
+			report.chartLatency.add(microsecondsSince(arrival));
+		
+		report.numberOfCandlesticks += static_cast<quint32>(batch.size());
+		++report.numberOfUpdates;
+		batch.clear();
+	}
+	
+	feeder.join();
+	report.seconds = std::chrono::duration<qreal>(Clock::now() - start).count();
+	return report;
+}
+
+quint32 HexReplayDriver::size(void) const
+{
+	return static_cast<quint32>(HexReplayDriver::day.lows.size());
+}
+
+#endif
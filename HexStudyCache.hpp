@@ -0,0 +1,184 @@
+#ifndef __HEX_STUDY_CACHE_HPP__
+#define __HEX_STUDY_CACHE_HPP__
+
+// Qt Libraries
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QString>
+
+// Standard Libraries
+#include <array>
+#include <bit>
+#include <cstring>
+
+// Personal Libraries
+#include "HexDayAnalysis.hpp"
+
+// Layout of a .hexs file (native byte order): the header below, then one study code per candlestick, as produced by
+// HexDayAnalysis::studyCodes.
+struct HexStudyHeader
+{
+	std::array<char, 4u>		magic = { 'H', 'E', 'X', 'S' };
+	quint32				version = 1u;
+	quint32				numberOfCandlesticks = 0u;
+	quint32				reserved = 0u;
+	
+	qreal				takeProfit = 0.;
+	qreal				stopLoss = 0.;
+};
+
+// Studies saved across sessions, one file per day content, TP and SL. The name starts with the SHA-1 of the day file,
+// so an edited file simply misses and its old studies age out. Reading a study maps its file and marks it as used;
+// once the directory grows past its capacity, the least recently used studies are removed. It is not thread-safe:
+// its owner reads and writes it from one thread and only runs the studies themselves in parallel.
+class HexStudyCache
+{
+	private:
+	
+		QDir					directory;
+		qint64					capacity;
+		
+		inline QString				entryPath(const QByteArray&, qreal, qreal) const;
+		inline void				evict(void);
+		inline bool				load(const QByteArray&, qreal, qreal, HexDayAnalysis&);
+		inline void				store(const QByteArray&, qreal, qreal, const HexDayAnalysis&);
+	
+	public:
+	
+		inline					HexStudyCache(const QString& = HexStudyCache::DefaultDirectory(), qint64 = 64ll << 20);
+		
+		inline static QString			DefaultDirectory(void);
+		inline static QByteArray		Key(const QString&);
+		
+		inline bool				restore(const QByteArray&, qreal, qreal, HexDayAnalysis&);
+		inline void				save(const QByteArray&, qreal, qreal, const HexDayAnalysis&);
+		inline void				study(const QString&, qreal, qreal, HexDayAnalysis&);
+};
+
+HexStudyCache::HexStudyCache(const QString& path, qint64 bytes) : directory(path), capacity(bytes)
+{
+	HexStudyCache::directory.mkpath(".");
+}
+
+QString HexStudyCache::DefaultDirectory(void)
+{
+	return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/studies";
+}
+
+QString HexStudyCache::entryPath(const QByteArray& key, qreal tp, qreal sl) const
+{
+	const auto tpBits = QString::number(std::bit_cast<quint64>(tp), 16);
+	const auto slBits = QString::number(std::bit_cast<quint64>(sl), 16);
+	return HexStudyCache::directory.filePath(QString::fromLatin1(key) + '-' + tpBits + '-' + slBits + ".hexs");
+}
+
+void HexStudyCache::evict(void)
+{
+	qint64 total = 0;
+	
+	for (const auto& info : HexStudyCache::directory.entryInfoList({ "*.hexs" }, QDir::Files, QDir::Time))
+	{
+		total += info.size();
+		
+		if (total > HexStudyCache::capacity)
+			QFile::remove(info.filePath());
+	}
+}
+
+// The hexadecimal SHA-1 of the file content, or an empty key when it cannot be read.
+QByteArray HexStudyCache::Key(const QString& filePath)
+{
+	QFile dataFile(filePath);
+	
+	if (!dataFile.open(QIODevice::ReadOnly))
+		return QByteArray();
+	
+	QCryptographicHash hash(QCryptographicHash::Sha1);
+	
+	if (!hash.addData(&dataFile))
+		return QByteArray();
+	
+	return hash.result().toHex();
+}
+
+// A file that does not fit the day is removed, so it is written again after the study.
+bool HexStudyCache::load(const QByteArray& key, qreal tp, qreal sl, HexDayAnalysis& analysis)
+{
+	QFile studyFile(HexStudyCache::entryPath(key, tp, sl));
+	
+	if (!studyFile.open(QIODevice::ReadOnly))
+		return false;
+	
+	const auto fileSize = static_cast<quint64>(studyFile.size());
+	const auto data = (fileSize >= sizeof(HexStudyHeader) ? studyFile.map(0, studyFile.size()) : nullptr);
+	HexStudyHeader header;
+	
+	if (data != nullptr)
+		std::memcpy(&header, data, sizeof(HexStudyHeader));
+	
+	if (data == nullptr or header.magic != HexStudyHeader().magic or header.version != 1u or header.takeProfit != tp or header.stopLoss != sl or
+		fileSize != sizeof(HexStudyHeader) + header.numberOfCandlesticks or !analysis.restoreStudy(tp, sl, data + sizeof(HexStudyHeader), header.numberOfCandlesticks))
+	{
+		studyFile.remove();
+		return false;
+	}
+	
+	studyFile.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+	return true;
+}
+
+// Gives the day the study of this TP and SL from the cache, if it has it. The key is the one of the day file, hashed
+// once by the caller for both the restore and the save after a miss; an empty key never hits.
+bool HexStudyCache::restore(const QByteArray& key, qreal tp, qreal sl, HexDayAnalysis& analysis)
+{
+	return (!key.isEmpty() and HexStudyCache::load(key, tp, sl, analysis));
+}
+
+void HexStudyCache::save(const QByteArray& key, qreal tp, qreal sl, const HexDayAnalysis& analysis)
+{
+	if (!key.isEmpty())
+		HexStudyCache::store(key, tp, sl, analysis);
+}
+
+void HexStudyCache::store(const QByteArray& key, qreal tp, qreal sl, const HexDayAnalysis& analysis)
+{
+	const auto codes = analysis.studyCodes();
+	
+	HexStudyHeader header;
+	header.numberOfCandlesticks = static_cast<quint32>(codes.size());
+	header.takeProfit = tp;
+	header.stopLoss = sl;
+	
+	QSaveFile studyFile(HexStudyCache::entryPath(key, tp, sl));
+	
+	if (!studyFile.open(QIODevice::WriteOnly))
+		return;
+	
+	studyFile.write(reinterpret_cast<const char*>(&header), sizeof(HexStudyHeader));
+	studyFile.write(reinterpret_cast<const char*>(codes.data()), static_cast<qint64>(codes.size()));
+	
+	if (studyFile.commit())
+		HexStudyCache::evict();
+}
+
+// Studies the day for this TP and SL the cheapest way: from its recent studies, from the cache, or from scratch,
+// in which case the result is saved for the next sessions.
+void HexStudyCache::study(const QString& filePath, qreal tp, qreal sl, HexDayAnalysis& analysis)
+{
+	if (analysis.recall(tp, sl))
+		return;
+	
+	const auto key = HexStudyCache::Key(filePath);
+	
+	if (HexStudyCache::restore(key, tp, sl, analysis))
+		return;
+	
+	analysis.study(tp, sl);
+	HexStudyCache::save(key, tp, sl, analysis);
+}
+
+#endif
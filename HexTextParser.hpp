@@ -0,0 +1,129 @@
+#ifndef __HEX_TEXT_PARSER_HPP__
+#define __HEX_TEXT_PARSER_HPP__
+
+// Qt Libraries
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+
+// Standard Libraries
+#include <array>
+#include <charconv>
+#include <string_view>
+
+// Personal Libraries
+#include "OtherClasses.hpp"
+
+// Parses a .txt day file (minima row, maxima row, then one "low high" row per second) into any sink exposing
+// setMinima, setMaxima, clear and saveCandlestick, the way loadHistory reads it: rows are split on single spaces.
+class HexTextParser
+{
+	private:
+	
+		inline static std::string_view	NextLine(std::string_view&);
+	
+	public:
+	
+		template <typename Sink>
+		inline static HexParseReport	Parse(const QString&, Sink&);
+		template <typename Sink>
+		inline static HexParseReport	Parse(std::string_view, Sink&);
+		template <std::size_t N>
+		inline static bool		ParseFields(std::string_view, std::array<qreal, N>&);
+};
+
+std::string_view HexTextParser::NextLine(std::string_view& text)
+{
+	const auto end = text.find('\n');
+	auto line = text.substr(0u, end);
+	text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1u);
+	
+	if (!line.empty() and line.back() == '\r')
+		line.remove_suffix(1u);
+	
+	return line;
+}
+
+template <typename Sink>
+HexParseReport HexTextParser::Parse(const QString& filePath, Sink& sink)
+{
+	QFile dataFile(filePath);
+	
+	if (!dataFile.open(QIODevice::ReadOnly))
+		return HexParseReport();
+	
+	const auto content = dataFile.readAll();
+	return HexTextParser::Parse(std::string_view(content.constData(), static_cast<std::size_t>(content.size())), sink);
+}
+
+template <typename Sink>
+HexParseReport HexTextParser::Parse(std::string_view text, Sink& sink)
+{
+	HexParseReport report;
+	std::array<qreal, 4u> minData;
+	std::array<qreal, 4u> maxData;
+	
+	if (!HexTextParser::ParseFields(HexTextParser::NextLine(text), minData))
+	{
+		report.error = HexParseReport::WrongMinimumData;
+		return report;
+	}
+	
+	if (!HexTextParser::ParseFields(HexTextParser::NextLine(text), maxData))
+	{
+		report.error = HexParseReport::WrongMaximumData;
+		return report;
+	}
+	
+	sink.setMinima(minData[0u], minData[1u], minData[2u], minData[3u]);
+	sink.setMaxima(maxData[0u], maxData[1u], maxData[2u], maxData[3u]);
+	sink.clear();
+	
+	std::array<qreal, 2u> data;
+	
+	while (!text.empty())
+	{
+		if (!HexTextParser::ParseFields(HexTextParser::NextLine(text), data))
+		{
+			report.error = HexParseReport::MalformedLine;
+			return report;
+		}
+		
+		sink.saveCandlestick(data[0u], data[1u]);
+		++report.lineCount;
+	}
+	
+	report.error = HexParseReport::None;
+	return report;
+}
+
+template <std::size_t N>
+bool HexTextParser::ParseFields(std::string_view line, std::array<qreal, N>& values)
+{
+	auto count = 0u;
+	
+	while (true)
+	{
+		const auto end = line.find(' ');
+		const auto field = line.substr(0u, end);
+		
+		if (count == N)
+			return false;
+		
+		const auto [pointer, error] = std::from_chars(field.data(), field.data() + field.size(), values[count]);
+		
+		if (error != std::errc() or pointer != field.data() + field.size())
+			return false;
+		
+		++count;
+		
+		if (end == std::string_view::npos)
+			break;
+		
+		line.remove_prefix(end + 1u);
+	}
+	
+	return count == N;
+}
+
+#endif
@@ -2,22 +2,46 @@
 #define __OTHER_CLASSES_HPP__
 
 // Qt Libraries
-#include <QBrush>
-#include <QGraphicsLineItem>
-#include <QGraphicsRectItem>
-#include <QGraphicsSimpleTextItem>
+#include <QString>
 
-struct HexCandlestick
+// Standard Libraries
+#include <array>
+#include <vector>
+
+// Personal Libraries
+#include "HexCoreTypes.hpp"
+
+struct HexArchiveEntry
 {
-	qreal		low;
-	qreal		high;
+	QString				instrument;
+	QString				date;
+	QString				filePath;
+	
+	qint64				fileSize = 0;
+	qint64				lastModified = 0;
+	quint32				numberOfCandlesticks = 0u;
 	
-	qreal		levelToBuyOrSell = 0.;
-	char		winningOrder = 'u';
-	char		breakOrDrop = '_';
+	std::array<qreal, 4u>		minima = { };
+	std::array<qreal, 4u>		maxima = { };
+	
+	inline void clear(void)
+	{
+		numberOfCandlesticks = 0u;
+	}
+	
+	inline void saveCandlestick(qreal, qreal)
+	{
+		++numberOfCandlesticks;
+	}
+	
+	inline void setMaxima(qreal d, qreal w, qreal m, qreal y)
+	{
+		maxima = { d, w, m, y };
+	}
 	
-	inline HexCandlestick(qreal l, qreal h) : low(l), high(h)
+	inline void setMinima(qreal d, qreal w, qreal m, qreal y)
 	{
+		minima = { d, w, m, y };
 	}
 };
 
@@ -32,42 +56,34 @@ struct HexCheckFile
 	bool		abort = true;
 };
 
-struct HexInfoFile
+struct HexLoadResult
 {
-	qreal		min = std::numeric_limits<qreal>::max();
-	qreal		rawMin = std::numeric_limits<qreal>::max();
-	
-	qreal		max = -std::numeric_limits<qreal>::max();
-	qreal		rawMax = -std::numeric_limits<qreal>::max();
+	HexParseReport			report;
+	QString				filePath;
+	bool				loaded = false;
 };
 
-struct HexLevelPack
+// The strips replace those of the chart from the first strip on; a first strip of 0 is a whole chart. The end second
+// is the session second at which the last strip ends.
+struct HexChartResult
 {
-	QGraphicsLineItem*		lineItem = nullptr;
-	qint32				level;
-	
-	inline HexLevelPack(qint32 l) : level(l)
-	{
-	}
+	std::vector<HexStrip>		strips;
+	QString				report;
+	QString				title;
+	quint32				firstStrip = 0u;
+	quint32				timeSpot = 0u;
+	quint32				endSecond = 0u;
+	quint32				dayLength = 0u;
+	bool				completed = false;
 };
 
-struct HexStrip
+struct HexReplayReport
 {
-	QGraphicsRectItem*		background = nullptr;
-	QBrush				brush;
-	
-	QString				timestamp;
-	QRectF				rectangle;
-	
-	qreal				low = 0.;
-	qreal				high = 0.;
-	
-	quint32				timeSpot;
-	char				breakOrDrop = '_';
-	
-	inline HexStrip(const QString& t, QRectF r, qreal l, qreal h, quint32 ts, char b) : timestamp(t), rectangle(r), low(l), high(h), timeSpot(ts), breakOrDrop(b)
-	{
-	}
+	HexLatencySamples		studyLatency;
+	HexLatencySamples		chartLatency;
+	quint32				numberOfCandlesticks = 0u;
+	quint32				numberOfUpdates = 0u;
+	qreal				seconds = 0.;
 };
 
 #endif
@@ -0,0 +1,498 @@
+#ifndef __Q_CANDLESTICK_ITEM_HPP__
+#define __Q_CANDLESTICK_ITEM_HPP__
+
+// Qt Libraries
+#include <QBrush>
+#include <QGraphicsItem>
+#include <QLineF>
+#include <QPainter>
+#include <QPen>
+#include <QRectF>
+#include <QTransform>
+
+// Standard Libraries
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+// Personal Libraries
+#include "HexProfiler.hpp"
+#include "OtherClasses.hpp"
+
+// The whole chart as one scene item. Backgrounds, level lines, time lines, bodies and break/drop markers are kept in
+// flat arrays and painted in a single paint() call, with one drawRects batch per brush. Strip i spans [i, i + 1) on
+// the x axis, so hit-testing is a floor, and batches are filled left to right, so a partial repaint only draws the
+// rects that cross its clip. Once strips get narrower than a device pixel, they are painted decimated
+// instead: one min/max column per pixel, with the strongest break and drop of each column kept as a marker.
+class QCandlestickItem : public QGraphicsItem
+{
+	private:
+	
+		typedef std::vector<std::pair<QBrush, std::vector<QRectF>>>	RectBatches;
+		
+		struct StripSummary
+		{
+			QRectF				body;
+			HexStrip::Shade			shade;
+			char				breakOrDrop;
+			char				timeDigit;
+		};
+		
+		inline static void			AddRect(RectBatches&, const QBrush&, const QRectF&);
+		inline static void			DrawRects(QPainter*, const std::vector<QRectF>&, qreal, qreal);
+		inline static quint32			MarkerRank(char);
+		inline static QBrush			MarkerBrush(char);
+		inline static QRectF			NonFlatRectangle(const QRectF&);
+		inline static QBrush			ShadeBrush(HexStrip::Shade);
+		inline static QRectF			StripBody(const HexStrip&, quint32);
+		
+		RectBatches				bodies;
+		RectBatches				markers;
+		RectBatches				columnBodies;
+		RectBatches				columnMarkers;
+		std::vector<StripSummary>		summaries;
+		QTransform				columnTransform;
+		std::vector<QLineF>			levelLines;
+		std::vector<QLineF>			timeLines;
+		
+		QRectF					backgroundRect;
+		QRectF					bounds;
+		QPen					outlinePen = QPen(Qt::NoPen);
+		qreal					markerHeight = 0.;
+		
+		quint32					numberOfStrips = 0u;
+		qint32					timeSpotStrip = -1;
+		
+		inline void				addStrip(const HexStrip&, quint32, char&);
+		inline void				decimate(const QTransform&);
+		inline QRectF				unitedBounds(void) const;
+	
+	public:
+	
+		static constexpr qreal			BodyWidth = 0.8f;
+		
+		inline QRectF				boundingRect(void) const override;
+		inline void				paint(QPainter*, const QStyleOptionGraphicsItem*, QWidget*) override;
+		inline void				paintChart(QPainter*);
+		inline QRectF				replaceStrips(const std::vector<HexStrip>&, quint32, qint32);
+		inline void				setLevels(const std::vector<qint32>&, qreal, qreal);
+		inline void				setStrips(const std::vector<HexStrip>&, quint32, qreal, bool);
+		inline qint32				stripAt(qreal) const;
+		inline QRectF				stripRect(qint32) const;
+};
+
+void QCandlestickItem::AddRect(RectBatches& batches, const QBrush& brush, const QRectF& rect)
+{
+	for (auto& batch : batches)
+	{
+		if (batch.first == brush)
+		{
+			batch.second.push_back(rect);
+			return;
+		}
+	}
+	
+	batches.emplace_back(brush, std::vector<QRectF>(1u, rect));
+}
+
+// The body, summary and marker of a strip of the chart, with a time line where the minute digit changes. Strips are
+// added left to right, after the background is set.
+void QCandlestickItem::addStrip(const HexStrip& strip, quint32 index, char& digit)
+{
+	const auto body = QCandlestickItem::StripBody(strip, index);
+	QCandlestickItem::AddRect(QCandlestickItem::bodies, QCandlestickItem::ShadeBrush(strip.shade), QCandlestickItem::NonFlatRectangle(body));
+	QCandlestickItem::summaries.push_back({ body, strip.shade, strip.breakOrDrop, strip.timestamp[4u] });
+	
+	if (strip.timestamp[4u] != digit)
+	{
+		QCandlestickItem::timeLines.emplace_back(static_cast<qreal>(index), QCandlestickItem::backgroundRect.bottom(), static_cast<qreal>(index), QCandlestickItem::backgroundRect.top());
+		digit = strip.timestamp[4u];
+	}
+	
+	if (static_cast<quint32>(strip.breakOrDrop) <= static_cast<quint32>('Z'))
+	{
+		const auto rect = QRectF(body.left() + 0.2, body.top() - 1.5*QCandlestickItem::markerHeight, body.width() - 0.4, QCandlestickItem::markerHeight);
+		QCandlestickItem::AddRect(QCandlestickItem::markers, QCandlestickItem::MarkerBrush(strip.breakOrDrop), rect);
+	}
+	else if (static_cast<quint32>(strip.breakOrDrop) >= static_cast<quint32>('a'))
+	{
+		const auto rect = QRectF(body.left() + 0.2, body.bottom() + 0.5*QCandlestickItem::markerHeight, body.width() - 0.4, QCandlestickItem::markerHeight);
+		QCandlestickItem::AddRect(QCandlestickItem::markers, QCandlestickItem::MarkerBrush(strip.breakOrDrop), rect);
+	}
+}
+
+QRectF QCandlestickItem::boundingRect(void) const
+{
+	return QCandlestickItem::bounds;
+}
+
+// One column per device pixel, over the strips that start in it. A column takes the shade of its strips when they all
+// share one and the mixed grey otherwise. Markers are a few pixels large whatever the scale, so a lone break stays
+// visible on a whole session.
+void QCandlestickItem::decimate(const QTransform& transform)
+{
+	HEX_PROFILE_SCOPE("QCandlestickItem::decimate");
+	
+	for (auto& batches : { &(QCandlestickItem::columnBodies), &(QCandlestickItem::columnMarkers) })
+		for (auto& batch : *batches)
+			batch.second.clear();
+	
+	QCandlestickItem::columnTransform = transform;
+	
+	const auto columnWidth = 1./transform.m11();
+	const auto pixelHeight = 1./std::abs(transform.m22());
+	const auto numberOfColumns = static_cast<quint32>(std::ceil(static_cast<qreal>(QCandlestickItem::numberOfStrips)*transform.m11()));
+	auto first = 0u;
+	
+	for (auto c = 0u; c < numberOfColumns and first < QCandlestickItem::numberOfStrips; ++c)
+	{
+		const auto last = std::min(static_cast<quint32>(std::ceil((c + 1u)*columnWidth)), QCandlestickItem::numberOfStrips);
+		
+		if (last <= first)
+			continue;
+		
+		auto top = std::numeric_limits<qreal>::max();
+		auto bottom = -std::numeric_limits<qreal>::max();
+		auto shade = QCandlestickItem::summaries[first].shade;
+		auto upper = '_';
+		auto lower = '_';
+		
+		for (auto i = first; i < last; ++i)
+		{
+			const auto& s = QCandlestickItem::summaries[i];
+			top = std::min(top, s.body.top());
+			bottom = std::max(bottom, s.body.bottom());
+			
+			if (s.shade != shade)
+				shade = HexStrip::Mixed;
+			
+			auto& marker = (static_cast<quint32>(s.breakOrDrop) <= static_cast<quint32>('Z') ? upper : lower);
+			
+			if (QCandlestickItem::MarkerRank(s.breakOrDrop) > QCandlestickItem::MarkerRank(marker))
+				marker = s.breakOrDrop;
+		}
+		
+		const auto left = c*columnWidth;
+		QCandlestickItem::AddRect(QCandlestickItem::columnBodies, QCandlestickItem::ShadeBrush(shade), QRectF(left, top, columnWidth, std::max(bottom - top, pixelHeight)));
+		
+		if (upper != '_')
+			QCandlestickItem::AddRect(QCandlestickItem::columnMarkers, QCandlestickItem::MarkerBrush(upper), QRectF(left - columnWidth, top - 6.*pixelHeight, 3.*columnWidth, 4.*pixelHeight));
+		
+		if (lower != '_')
+			QCandlestickItem::AddRect(QCandlestickItem::columnMarkers, QCandlestickItem::MarkerBrush(lower), QRectF(left - columnWidth, bottom + 2.*pixelHeight, 3.*columnWidth, 4.*pixelHeight));
+		
+		first = last;
+	}
+}
+
+// The rects of a left to right batch that cross [left, right], found by bisection.
+void QCandlestickItem::DrawRects(QPainter* painter, const std::vector<QRectF>& rects, qreal left, qreal right)
+{
+	const auto first = std::partition_point(rects.begin(), rects.end(), [left](const QRectF& r) { return r.right() < left; });
+	const auto last = std::partition_point(first, rects.end(), [right](const QRectF& r) { return r.left() <= right; });
+	painter->drawRects(rects.data() + (first - rects.begin()), static_cast<qint32>(last - first));
+}
+
+QBrush QCandlestickItem::MarkerBrush(char breakOrDrop)
+{
+	switch (breakOrDrop)
+	{
+		case 'D':
+			return QColor(102, 153, 255);
+		
+		case 'W':
+			return QColor(0, 85, 255);
+		
+		case 'M':
+			return QColor(0, 42, 127);
+		
+		case 'd':
+			return QColor(255, 102, 102);
+		
+		case 'w':
+			return QColor(255, 0, 0);
+		
+		case 'm':
+			return QColor(127, 0, 0);
+		
+		default:
+			return QColor(0, 0, 0);
+	}
+}
+
+// Years outrank months, weeks and days; no break or drop ranks last.
+quint32 QCandlestickItem::MarkerRank(char breakOrDrop)
+{
+	switch (breakOrDrop)
+	{
+		case 'D':
+		case 'd':
+			return 1u;
+		
+		case 'W':
+		case 'w':
+			return 2u;
+		
+		case 'M':
+		case 'm':
+			return 3u;
+		
+		case 'Y':
+		case 'y':
+			return 4u;
+		
+		default:
+			return 0u;
+	}
+}
+
+QRectF QCandlestickItem::NonFlatRectangle(const QRectF& rect)
+{
+	if (rect.height() != 0.f)
+		return rect;
+	
+	return QRectF(rect.left(), rect.top() - 0.02f, rect.width(), 0.04f);
+}
+
+// With profiling, every paint ends a profiler frame, once its own timer is recorded.
+void QCandlestickItem::paint(QPainter* painter, const QStyleOptionGraphicsItem*, QWidget*)
+{
+	QCandlestickItem::paintChart(painter);
+	
+	if constexpr (HexProfiler::Enabled)
+		HexProfiler::EndFrame();
+}
+
+// The decimated columns are only rebuilt when the scale changes, so scrolling at the same zoom repaints them as is.
+// Off-screen renders call it directly, so they do not end a profiler frame. Without a clip, everything is drawn.
+void QCandlestickItem::paintChart(QPainter* painter)
+{
+	HEX_PROFILE_SCOPE("QCandlestickItem::paint");
+	
+	if (QCandlestickItem::numberOfStrips == 0u)
+		return;
+	
+	const auto& transform = painter->worldTransform();
+	const auto decimated = (transform.m11() < 1.);
+	
+	if (decimated and (transform.m11() != QCandlestickItem::columnTransform.m11() or transform.m22() != QCandlestickItem::columnTransform.m22()))
+		QCandlestickItem::decimate(transform);
+	
+	const auto shownStrip = [&](qint32 index)
+	{
+		auto rect = QCandlestickItem::stripRect(index);
+		
+		if (decimated)
+			rect.setWidth(1./transform.m11());
+		
+		return rect;
+	};
+	
+	const auto clip = (painter->hasClipping() ? painter->clipBoundingRect() : QRectF());
+	const auto left = (clip.isEmpty() ? -std::numeric_limits<qreal>::max() : clip.left());
+	const auto right = (clip.isEmpty() ? std::numeric_limits<qreal>::max() : clip.right());
+	
+	painter->fillRect(QCandlestickItem::backgroundRect, Qt::white);
+	
+	if (QCandlestickItem::timeSpotStrip >= 0)
+		painter->fillRect(shownStrip(QCandlestickItem::timeSpotStrip), QColor(204, 255, 204));
+	
+	painter->setPen(QPen(Qt::black, 0.));
+	painter->drawLines(QCandlestickItem::levelLines.data(), static_cast<qint32>(QCandlestickItem::levelLines.size()));
+	
+	painter->setPen(QPen(Qt::black, 0., Qt::DotLine));
+	painter->drawLines(QCandlestickItem::timeLines.data(), static_cast<qint32>(QCandlestickItem::timeLines.size()));
+	
+	painter->setPen(decimated ? QPen(Qt::NoPen) : QCandlestickItem::outlinePen);
+	
+	const auto bodyBatches = (decimated ? &(QCandlestickItem::columnBodies) : &(QCandlestickItem::bodies));
+	const auto markerBatches = (decimated ? &(QCandlestickItem::columnMarkers) : &(QCandlestickItem::markers));
+	
+	for (const auto& batches : { bodyBatches, markerBatches })
+	{
+		for (const auto& [brush, rects] : *batches)
+		{
+			painter->setBrush(brush);
+			QCandlestickItem::DrawRects(painter, rects, left, right);
+		}
+	}
+}
+
+// Replaces the strips from the first one on with strips of the same price range, so the background and the scale
+// stay as they are. Batches are filled left to right, so the replaced rects are cut off their ends. Returns the scene
+// rect to repaint, from the first replaced strip or the time spot strip it leaves, whichever comes first.
+QRectF QCandlestickItem::replaceStrips(const std::vector<HexStrip>& tail, quint32 first, qint32 newTimeSpotStrip)
+{
+	HEX_PROFILE_SCOPE("QCandlestickItem::replaceStrips");
+	first = std::min(first, static_cast<quint32>(QCandlestickItem::summaries.size()));
+	const auto left = static_cast<qreal>(first);
+	
+	for (auto& batches : { &(QCandlestickItem::bodies), &(QCandlestickItem::markers) })
+		for (auto& batch : *batches)
+			batch.second.erase(std::partition_point(batch.second.begin(), batch.second.end(), [left](const QRectF& r) { return r.left() < left; }), batch.second.end());
+	
+	auto& lines = QCandlestickItem::timeLines;
+	lines.erase(std::partition_point(lines.begin(), lines.end(), [left](const QLineF& l) { return l.x1() < left; }), lines.end());
+	QCandlestickItem::summaries.resize(first);
+	
+	auto digit = (first > 0u ? QCandlestickItem::summaries.back().timeDigit : tail.front().timestamp.at(4u));
+	
+	for (auto i = 0u; i < tail.size(); ++i)
+		QCandlestickItem::addStrip(tail[i], first + i, digit);
+	
+	auto dirtyLeft = left;
+	
+	for (const auto strip : { QCandlestickItem::timeSpotStrip, newTimeSpotStrip })
+		if (strip >= 0)
+			dirtyLeft = std::min(dirtyLeft, static_cast<qreal>(strip));
+	
+	QCandlestickItem::numberOfStrips = first + static_cast<quint32>(tail.size());
+	QCandlestickItem::timeSpotStrip = newTimeSpotStrip;
+	QCandlestickItem::columnTransform = QTransform();
+	
+	const auto bounds = QCandlestickItem::unitedBounds();
+	
+	if (bounds != QCandlestickItem::bounds)
+	{
+		QGraphicsItem::prepareGeometryChange();
+		QCandlestickItem::bounds = bounds;
+	}
+	
+	const auto dirtyRect = QRectF(dirtyLeft, bounds.top(), static_cast<qreal>(QCandlestickItem::numberOfStrips) - dirtyLeft, bounds.height());
+	QGraphicsItem::update(dirtyRect);
+	return dirtyRect;
+}
+
+// Levels are drawn as horizontal lines from left to right.
+void QCandlestickItem::setLevels(const std::vector<qint32>& levels, qreal left, qreal right)
+{
+	QGraphicsItem::prepareGeometryChange();
+	QCandlestickItem::levelLines.clear();
+	QCandlestickItem::levelLines.reserve(levels.size());
+	
+	for (const auto level : levels)
+		QCandlestickItem::levelLines.emplace_back(left, static_cast<qreal>(level), right, static_cast<qreal>(level));
+	
+	QCandlestickItem::bounds = QCandlestickItem::unitedBounds();
+	QGraphicsItem::update();
+}
+
+// The marker height is the scene height of the strip width on screen, so markers stay square whatever the zoom.
+// Batches are emptied rather than dropped, so scrolling refills the same storage without allocating.
+void QCandlestickItem::setStrips(const std::vector<HexStrip>& strips, quint32 timeSpot, qreal markerHeight, bool outlined)
+{
+	HEX_PROFILE_SCOPE("QCandlestickItem::setStrips");
+	QGraphicsItem::prepareGeometryChange();
+	
+	for (auto& batches : { &(QCandlestickItem::bodies), &(QCandlestickItem::markers) })
+		for (auto& batch : *batches)
+			batch.second.clear();
+	
+	QCandlestickItem::timeLines.clear();
+	QCandlestickItem::summaries.clear();
+	QCandlestickItem::columnTransform = QTransform();
+	
+	QCandlestickItem::numberOfStrips = static_cast<quint32>(strips.size());
+	QCandlestickItem::timeSpotStrip = -1;
+	QCandlestickItem::markerHeight = markerHeight;
+	QCandlestickItem::outlinePen = (outlined ? QPen(Qt::black, 0.) : QPen(Qt::NoPen));
+	
+	if (strips.empty())
+	{
+		QCandlestickItem::backgroundRect = QRectF();
+		QCandlestickItem::bounds = QCandlestickItem::unitedBounds();
+		return;
+	}
+	
+	auto maxHeight = -std::numeric_limits<qreal>::max();
+	auto minHeight = std::numeric_limits<qreal>::max();
+	
+	for (auto i = 0u; i < strips.size(); ++i)
+	{
+		const auto rect = QCandlestickItem::StripBody(strips[i], i);
+		
+		if (rect.top() < minHeight)
+			minHeight = rect.top();
+		
+		if (rect.bottom() > maxHeight)
+			maxHeight = rect.bottom();
+	}
+	
+	QCandlestickItem::backgroundRect = QRectF(0., minHeight - 5., static_cast<qreal>(strips.size()), maxHeight - minHeight + 10.);
+	auto digit = strips[0u].timestamp.at(4u);
+	
+	for (auto i = 0u; i < strips.size(); ++i)
+	{
+		if (strips[i].timeSpot == timeSpot)
+			QCandlestickItem::timeSpotStrip = static_cast<qint32>(i);
+		
+		QCandlestickItem::addStrip(strips[i], i, digit);
+	}
+	
+	QCandlestickItem::bounds = QCandlestickItem::unitedBounds();
+	QGraphicsItem::update();
+}
+
+// Certain outcomes are solid, likely ones dotted, and grey means both sides or neither can win.
+QBrush QCandlestickItem::ShadeBrush(HexStrip::Shade shade)
+{
+	switch (shade)
+	{
+		case HexStrip::BuyCertain:
+			return QBrush(QColor(102, 153, 255));
+		
+		case HexStrip::SellCertain:
+			return QBrush(QColor(255, 102, 102));
+		
+		case HexStrip::BuyLikely:
+			return QBrush(QColor(102, 153, 255), Qt::Dense4Pattern);
+		
+		case HexStrip::SellLikely:
+			return QBrush(QColor(255, 102, 102), Qt::Dense4Pattern);
+		
+		case HexStrip::Undecided:
+			return QBrush(QColor(153, 153, 255), Qt::Dense4Pattern);
+		
+		default:
+			return QBrush(QColor(153, 153, 153));
+	}
+}
+
+qint32 QCandlestickItem::stripAt(qreal x) const
+{
+	const auto index = std::floor(x);
+	
+	if (index < 0. or index >= static_cast<qreal>(QCandlestickItem::numberOfStrips))
+		return -1;
+	
+	return static_cast<qint32>(index);
+}
+
+// Prices grow upwards on screen, hence the negated extrema.
+QRectF QCandlestickItem::StripBody(const HexStrip& strip, quint32 index)
+{
+	return QRectF(static_cast<qreal>(index) + 0.1f, -strip.high, QCandlestickItem::BodyWidth, strip.high - strip.low);
+}
+
+QRectF QCandlestickItem::stripRect(qint32 index) const
+{
+	return QRectF(static_cast<qreal>(index), QCandlestickItem::backgroundRect.top(), 1., QCandlestickItem::backgroundRect.height());
+}
+
+QRectF QCandlestickItem::unitedBounds(void) const
+{
+	auto rect = QCandlestickItem::backgroundRect;
+	
+	for (const auto& line : QCandlestickItem::levelLines)
+		rect |= QRectF(line.p1(), line.p2()).normalized().adjusted(0., -0.5, 0., 0.5);
+	
+	for (const auto& [brush, rects] : QCandlestickItem::markers)
+		for (const auto& r : rects)
+			rect |= r;
+	
+	return rect;
+}
+
+#endif
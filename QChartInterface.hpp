@@ -5,22 +5,39 @@
 #include <QButtonGroup>
 #include <QCheckBox>
 #include <QDoubleValidator>
+#include <QFile>
 #include <QFileDialog>
+#include <QFontDatabase>
+#include <QFutureWatcher>
 #include <QGraphicsView>
 #include <QGridLayout>
+#include <QInputDialog>
 #include <QKeyEvent>
 #include <QLabel>
 #include <QMainWindow>
+#include <QProgressBar>
 #include <QPushButton>
 #include <QScrollBar>
 #include <QTextBrowser>
+#include <QTextCursor>
+#include <QTextDocument>
+#include <QThreadPool>
+#include <QTimer>
+#include <QVBoxLayout>
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtConcurrent/QtConcurrentRun>
 
 // Standard Libraries
+#include <atomic>
 #include <iostream>
+#include <utility>
+#include <vector>
 
 // Personal Libraries
-#include "HexDayAnalysis.hpp"
-#include "QCustomGraphicsScene.hpp"
+#include "HexChartEngine.hpp"
+#include "QChartNavigator.hpp"
+#include "QChartPane.hpp"
+#include "QLiveFeed.hpp"
 
 class QChartInterface : public QMainWindow
 {
@@ -28,12 +45,13 @@ class QChartInterface : public QMainWindow
 	
 	private:
 		
-		inline static QRectF			NonFlatRectangle(const QRectF&);
+		static constexpr qint32			LogBlocks = 5'000;
 		
 		QWidget* const				mainWidget = new QWidget();
 		
-		QGraphicsView* const			candlestickView = new QGraphicsView(mainWidget);
-		QCustomGraphicsScene* const		candlestickScene = new QCustomGraphicsScene(mainWidget, sceneItemInfo);
+		QWidget* const				paneArea = new QWidget(mainWidget);
+		QChartPane* const			mainPane = new QChartPane(paneArea);
+		QChartNavigator* const			navigator = new QChartNavigator(mainPane->view());
 		
 		QLabel* const				fileLabel = new QLabel("No file loaded.", mainWidget);
 		QLineEdit* const			cursorEdit = new QLineEdit(mainWidget);
@@ -48,6 +66,7 @@ class QChartInterface : public QMainWindow
 		QLineEdit* const			stopLossEdit = new QLineEdit(mainWidget);
 		
 		QCheckBox* const			eIBox = new QCheckBox("Elemental Increment", mainWidget);
+		QCheckBox* const			allBox = new QCheckBox("All Instruments", mainWidget);
 		QButtonGroup* const			buttonGroup = new QButtonGroup(mainWidget);
 		
 		QCheckBox* const			level005Box = new QCheckBox("5", mainWidget);
@@ -59,30 +78,53 @@ class QChartInterface : public QMainWindow
 		QCheckBox* const			level500Box = new QCheckBox("500", mainWidget);
 		
 		QTextBrowser* const			informationPanel = new QTextBrowser(mainWidget);
-		const QString				logHeader = "<html><head><style>p.small { line-height: 0.4; }</style></head><body>";
-		const QString				logFooter = "</body></html>";
+		QProgressBar* const			progressBar = new QProgressBar(mainWidget);
+		QLabel* const				profileOverlay = new QLabel(mainPane->view());
+		QTimer* const				profileTimer = new QTimer(this);
+		QLiveFeed* const			liveFeed = new QLiveFeed(this);
 		
-		QString					logBody;
-		QRectF					candlestickRect;
+		std::vector<QChartPane*>		panes = { mainPane };
 		
-		HexDayAnalysis				savedInformation;
-		std::vector<HexStrip>			sceneItemInfo;
-		std::vector<HexLevelPack>		levelPacks;
+		HexChartEngine				engine;
+		QThreadPool				workerPool;
+		std::atomic<quint32>			latestDraw = 0u;
+		quint32					pendingJobs = 0u;
+		quint32					tileGeneration = 0u;
 		
+		std::vector<std::pair<qreal, qreal>>	liveCandlesticks;
+		QString					liveSource;
+		bool					liveJobPending = false;
+		bool					liveSampleShown = false;
+		
+		inline void				appendLog(const QString&);
 		inline HexCheckFile			check(void);
+		inline void				clearLog(void);
+		inline void				connectPane(QChartPane*);
 		inline void				drawBlackLines(void);
-		inline void				drawCandlesticks(quint32, quint32, quint32, qreal, qreal);
-		inline void				drawTimeLines(void);
-		inline void				updateCandlesticks(std::vector<HexStrip>&, quint32);
-		inline void				updateInformationPanel(void);
+		inline void				drawCandlesticks(quint32, quint32, quint32, qreal, qreal, const QString& = "");
+		inline void				exportTrace(void);
+		inline void				flushLive(void);
+		inline void				forgetTiles(void);
+		inline bool				reportLoadFailure(const HexLoadResult&);
+		template <typename Result, typename Job, typename Handler>
+		inline void				runInBackground(Job&&, Handler&&);
+		inline void				showPanes(quint32);
+		inline void				switchDay(qint32);
+		inline void				toggleProfileOverlay(void);
+		inline void				updateProfileOverlay(void);
 	
 	private slots:
 	
+		inline void				liveStopped(const QString&);
 		inline void				loadHistory(void);
+		inline void				receiveCandlestick(qreal, qreal);
+		inline void				renderTiles(const QList<QChartTileKey>&);
 		inline void				reset(void);
 		inline void				showCandlesticks(void);
 		inline void				showNewCandlesticks(const QUrl&);
+		inline void				startLiveSession(const HexColumns&);
 		inline void				study(void);
+		inline void				toggleLive(void);
 		inline void				updateBlackLines(void);
 	
 	protected:
@@ -99,14 +141,15 @@ QChartInterface::QChartInterface(void) : QMainWindow()
 	QMainWindow::setWindowTitle("Custom Chart Study");
 	QMainWindow::setCentralWidget(QChartInterface::mainWidget);
 	
-	QChartInterface::candlestickScene->setEdits(QChartInterface::highEdit, QChartInterface::lowEdit, QChartInterface::timestampEdit, QChartInterface::cursorEdit);
+	QChartInterface::mainPane->scene()->setEdits(QChartInterface::highEdit, QChartInterface::lowEdit, QChartInterface::timestampEdit, QChartInterface::cursorEdit);
 
 	const auto loadButton = new QPushButton("Load", this);
+	const auto liveButton = new QPushButton("Live", this);
 	const auto resetButton = new QPushButton("Reset", this);
 	const auto showButton = new QPushButton("Show", this);
 	const auto studyButton = new QPushButton("Study", this);
 	
-	const auto cList = { loadButton, resetButton, showButton, studyButton };
+	const auto cList = { loadButton, liveButton, resetButton, showButton, studyButton };
 	const auto layout = new QGridLayout();
 	auto count = 0;
 	
@@ -154,7 +197,7 @@ QChartInterface::QChartInterface(void) : QMainWindow()
 	const auto chartSizeLabel = new QLabel("NC", this);
 	chartSizeLabel->setMaximumWidth(20);
 	QChartInterface::chartSizeEdit->setValidator(intValidator);
-	QChartInterface::chartSizeEdit->setMaximumWidth(40);
+	QChartInterface::chartSizeEdit->setMaximumWidth(50);
 	
 	const auto takeProfLabel = new QLabel("TP", this);
 	takeProfLabel->setMaximumWidth(20);
@@ -195,24 +238,44 @@ QChartInterface::QChartInterface(void) : QMainWindow()
 	}
 	
 	layout->addWidget(QChartInterface::eIBox, 0, count++, 1, 1);
+	layout->addWidget(QChartInterface::allBox, 0, count++, 1, 1);
+	
+	QChartInterface::workerPool.setMaxThreadCount(1);
+	
+	QChartInterface::progressBar->setRange(0, 0);
+	QChartInterface::progressBar->setTextVisible(false);
+	QChartInterface::progressBar->hide();
+	
+	QChartInterface::profileOverlay->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+	QChartInterface::profileOverlay->setStyleSheet("QLabel { background-color: white; border: 1px solid gray; padding: 4px; }");
+	QChartInterface::profileOverlay->setAutoFillBackground(true);
+	QChartInterface::profileOverlay->move(10, 10);
+	QChartInterface::profileOverlay->hide();
+	QChartInterface::profileTimer->setInterval(250);
 	
 	QChartInterface::informationPanel->setMinimumWidth(300);
 	QChartInterface::informationPanel->setReadOnly(true);
 	QChartInterface::informationPanel->setOpenLinks(false);
+	QChartInterface::informationPanel->setUndoRedoEnabled(false);
+	QChartInterface::informationPanel->document()->setDefaultStyleSheet("p.small { line-height: 0.4; }");
+	QChartInterface::informationPanel->document()->setMaximumBlockCount(QChartInterface::LogBlocks);
 	
-	QChartInterface::candlestickView->setMinimumWidth(1'800);
-	QChartInterface::candlestickView->setMinimumHeight(800);
-	QChartInterface::candlestickView->setScene(QChartInterface::candlestickScene);
-	QChartInterface::candlestickView->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
-	QChartInterface::candlestickView->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
-	QChartInterface::candlestickView->setViewportUpdateMode(QGraphicsView::NoViewportUpdate);
-	QChartInterface::candlestickView->setFocusPolicy(Qt::NoFocus);
+	const auto paneLayout = new QVBoxLayout();
+	paneLayout->setContentsMargins(0, 0, 0, 0);
+	paneLayout->addWidget(QChartInterface::mainPane);
+	QChartInterface::paneArea->setLayout(paneLayout);
+	QChartInterface::paneArea->setMinimumWidth(1'800);
+	QChartInterface::paneArea->setMinimumHeight(800);
+	
+	QChartInterface::connectPane(QChartInterface::mainPane);
 	
 	layout->addWidget(QChartInterface::informationPanel, 1, 0, 5, 4);
-	layout->addWidget(QChartInterface::candlestickView, 1, 4, 5, count - 4);
+	layout->addWidget(QChartInterface::progressBar, 6, 0, 1, 4);
+	layout->addWidget(QChartInterface::paneArea, 1, 4, 5, count - 4);
 	QChartInterface::mainWidget->setLayout(layout);
 
 	QObject::connect(loadButton, SIGNAL(clicked(void)), this, SLOT(loadHistory(void)));
+	QObject::connect(liveButton, SIGNAL(clicked(void)), this, SLOT(toggleLive(void)));
 	QObject::connect(resetButton, SIGNAL(clicked(void)), this, SLOT(reset(void)));
 	QObject::connect(showButton, SIGNAL(clicked(void)), this, SLOT(showCandlesticks(void)));
 	QObject::connect(studyButton, SIGNAL(clicked(void)), this, SLOT(study(void)));
@@ -223,11 +286,44 @@ QChartInterface::QChartInterface(void) : QMainWindow()
 	QObject::connect(QChartInterface::level100Box, SIGNAL(toggled(bool)), this, SLOT(updateBlackLines(void)));
 	QObject::connect(QChartInterface::level250Box, SIGNAL(toggled(bool)), this, SLOT(updateBlackLines(void)));
 	QObject::connect(QChartInterface::level500Box, SIGNAL(toggled(bool)), this, SLOT(updateBlackLines(void)));
+	QObject::connect(QChartInterface::allBox, &QCheckBox::toggled, this, [this](void)
+	{
+		if (QChartInterface::fileLabel->text() != "No file loaded.")
+			QChartInterface::showCandlesticks();
+	});
 	QObject::connect(QChartInterface::informationPanel, SIGNAL(anchorClicked(const QUrl&)), this, SLOT(showNewCandlesticks(const QUrl&)));
+	QObject::connect(QChartInterface::liveFeed, &QLiveFeed::extremaReceived, this, &QChartInterface::startLiveSession);
+	QObject::connect(QChartInterface::liveFeed, &QLiveFeed::candlestickReceived, this, &QChartInterface::receiveCandlestick);
+	QObject::connect(QChartInterface::liveFeed, &QLiveFeed::stopped, this, &QChartInterface::liveStopped);
+	QObject::connect(QChartInterface::profileTimer, &QTimer::timeout, this, &QChartInterface::updateProfileOverlay);
+	QObject::connect(QChartInterface::navigator, &QChartNavigator::tilesMissing, this, &QChartInterface::renderTiles);
+	QObject::connect(QChartInterface::navigator, &QChartNavigator::windowChosen, this, [this](quint32 timeSpot, quint32 numberOfCandlesticks)
+	{
+		QChartInterface::timeSpotEdit->setText(QString::number(timeSpot));
+		QChartInterface::chartSizeEdit->setText(QString::number(numberOfCandlesticks));
+		QChartInterface::showCandlesticks();
+	});
 	
 	QChartInterface::reset();
 }
 
+// Only the new fragment is parsed and laid out, in a block of its own after the last one. The document keeps its last
+// LogBlocks blocks, so a long session neither grows the log nor slows its appends down.
+void QChartInterface::appendLog(const QString& fragment)
+{
+	const auto document = QChartInterface::informationPanel->document();
+	QTextCursor cursor(document);
+	cursor.movePosition(QTextCursor::End);
+	
+	if (!document->isEmpty())
+		cursor.insertBlock(QTextBlockFormat(), QTextCharFormat());
+	
+	cursor.insertHtml(fragment);
+	
+	const auto scrollbar = QChartInterface::informationPanel->verticalScrollBar();
+	scrollbar->setValue(scrollbar->maximum());
+}
+
 HexCheckFile QChartInterface::check(void)
 {
 	HexCheckFile foo;
@@ -236,8 +332,13 @@ HexCheckFile QChartInterface::check(void)
 	
 	if (foo.numberOfCandlesticks < 100u)
 	{
-		QChartInterface::logBody += "<p.small>(" + QTime::currentTime().toString("hh:mm:ss") + ") Chart must have at least 100 candlesticks.</p>";
-		QChartInterface::updateInformationPanel();
+		QChartInterface::appendLog("<p.small>(" + QTime::currentTime().toString("hh:mm:ss") + ") Chart must have at least 100 candlesticks.</p>");
+		return foo;
+	}
+	
+	if (foo.numberOfCandlesticks > 23'400u)
+	{
+		QChartInterface::appendLog("<p.small>(" + QTime::currentTime().toString("hh:mm:ss") + ") Chart must have at most 23400 candlesticks.</p>");
 		return foo;
 	}
 	
@@ -245,8 +346,7 @@ HexCheckFile QChartInterface::check(void)
 	
 	if (foo.timeUnit < 1u or foo.timeUnit > 180u)
 	{
-		QChartInterface::logBody += "<p.small>(" + QTime::currentTime().toString("hh:mm:ss") + ") Time unit out of range.</p>";
-		QChartInterface::updateInformationPanel();
+		QChartInterface::appendLog("<p.small>(" + QTime::currentTime().toString("hh:mm:ss") + ") Time unit out of range.</p>");
 		return foo;
 	}
 	
@@ -254,8 +354,7 @@ HexCheckFile QChartInterface::check(void)
 	
 	if (tp < 0.25)
 	{
-		QChartInterface::logBody += "<p.small>(" + QTime::currentTime().toString("hh:mm:ss") + ") TP must be at least 0.25.</p>";
-		QChartInterface::updateInformationPanel();
+		QChartInterface::appendLog("<p.small>(" + QTime::currentTime().toString("hh:mm:ss") + ") TP must be at least 0.25.</p>");
 		return foo;
 	}
 	
@@ -263,8 +362,7 @@ HexCheckFile QChartInterface::check(void)
 	
 	if (sl < 0.)
 	{
-		QChartInterface::logBody += "<p.small>(" + QTime::currentTime().toString("hh:mm:ss") + ") SL must be at least 0.</p>";
-		QChartInterface::updateInformationPanel();
+		QChartInterface::appendLog("<p.small>(" + QTime::currentTime().toString("hh:mm:ss") + ") SL must be at least 0.</p>");
 		return foo;
 	}
 	
@@ -274,97 +372,191 @@ HexCheckFile QChartInterface::check(void)
 	return foo;
 }
 
+void QChartInterface::clearLog(void)
+{
+	QChartInterface::informationPanel->document()->clear();
+}
+
+// The second hovered in a pane is highlighted in all the others.
+void QChartInterface::connectPane(QChartPane* pane)
+{
+	QObject::connect(pane, &QChartPane::secondHovered, this, [this, pane](qint64 second)
+	{
+		for (const auto other : QChartInterface::panes)
+			if (other != pane)
+				other->highlightSecond(second);
+	});
+}
+
+// Levels follow the price range of each pane.
 void QChartInterface::drawBlackLines(void)
 {
-	const auto minValue = static_cast<qint32>(QChartInterface::candlestickRect.top() - 0.5f)/5*5;
-	const auto maxValue = static_cast<qint32>(QChartInterface::candlestickRect.bottom() - 4.5f)/5*5;
+	HEX_PROFILE_SCOPE("QChartInterface::drawBlackLines");
 	
-	std::vector<HexLevelPack> newPacks;
-	newPacks.reserve(static_cast<quint32>(maxValue - minValue)/5u + 1u);
-	
-	for (auto i = minValue; i <= maxValue; i += 5)
+	for (const auto pane : QChartInterface::panes)
 	{
-		if (QChartInterface::level500Box->isChecked() and i % 500 == 0)
-			newPacks.emplace_back(i);
-		else if (QChartInterface::level250Box->isChecked() and i % 250 == 0)
-			newPacks.emplace_back(i);
-		else if (QChartInterface::level100Box->isChecked() and i % 100 == 0)
-			newPacks.emplace_back(i);
-		else if (QChartInterface::level050Box->isChecked() and i % 50 == 0)
-			newPacks.emplace_back(i);
-		else if (QChartInterface::level025Box->isChecked() and i % 25 == 0)
-			newPacks.emplace_back(i);
-		else if (QChartInterface::level010Box->isChecked() and i % 10 == 0)
-			newPacks.emplace_back(i);
-		else if (QChartInterface::level005Box->isChecked())
-			newPacks.emplace_back(i);
+		if (pane->isHidden())
+			continue;
+		
+		const auto& candlestickRect = pane->chartRect();
+		const auto minValue = static_cast<qint32>(candlestickRect.top() - 0.5f)/5*5;
+		const auto maxValue = static_cast<qint32>(candlestickRect.bottom() - 4.5f)/5*5;
+		
+		std::vector<qint32> levels;
+		levels.reserve(static_cast<quint32>(std::max(maxValue - minValue, 0))/5u + 1u);
+		
+		for (auto i = minValue; i <= maxValue; i += 5)
+		{
+			if (QChartInterface::level500Box->isChecked() and i % 500 == 0)
+				levels.push_back(i);
+			else if (QChartInterface::level250Box->isChecked() and i % 250 == 0)
+				levels.push_back(i);
+			else if (QChartInterface::level100Box->isChecked() and i % 100 == 0)
+				levels.push_back(i);
+			else if (QChartInterface::level050Box->isChecked() and i % 50 == 0)
+				levels.push_back(i);
+			else if (QChartInterface::level025Box->isChecked() and i % 25 == 0)
+				levels.push_back(i);
+			else if (QChartInterface::level010Box->isChecked() and i % 10 == 0)
+				levels.push_back(i);
+			else if (QChartInterface::level005Box->isChecked())
+				levels.push_back(i);
+		}
+		
+		pane->scene()->chart()->setLevels(levels, candlestickRect.left(), candlestickRect.right());
 	}
+}
+
+void QChartInterface::drawCandlesticks(quint32 sampleTimeSpot, quint32 numberOfCandlesticks, quint32 timeUnit, qreal tp, qreal sl, const QString& timeString)
+{
+	const auto generation = ++QChartInterface::latestDraw;
+	QChartInterface::liveSampleShown = false;
 	
-	const auto newEnd = newPacks.end();
-	auto newIt = newPacks.begin();
-	
-	const auto oldEnd = QChartInterface::levelPacks.end();
-	auto oldIt = QChartInterface::levelPacks.begin();
+	const auto allInstruments = QChartInterface::allBox->isChecked();
 	
-	QPen pen(Qt::black);
-	pen.setWidth(0);
+	const auto job = [this, generation, sampleTimeSpot, numberOfCandlesticks, timeUnit, tp, sl, timeString, allInstruments](void)
+	{
+		if (generation != QChartInterface::latestDraw)
+			return std::vector<HexChartResult>();
+		
+		return QChartInterface::engine.draw(sampleTimeSpot, numberOfCandlesticks, timeUnit, tp, sl, timeString, allInstruments);
+	};
 	
-	while (newIt != newEnd or oldIt != oldEnd)
+	const auto handler = [this, generation, numberOfCandlesticks, timeUnit, tp, sl](std::vector<HexChartResult> results)
 	{
-		if (newIt == newEnd or (oldIt != oldEnd and oldIt->level < newIt->level))
-		{
-			QChartInterface::candlestickScene->removeItem(oldIt->lineItem);
-			delete oldIt->lineItem;
-
-			++oldIt;
-			continue;
-		}
+		if (generation != QChartInterface::latestDraw or results.empty())
+			return;
+		
+		const auto& mainResult = results.front();
+		
+		if (!QChartInterface::liveFeed->isRunning() and !mainResult.strips.empty())
+			QChartInterface::navigator->setChart(mainResult.strips.front().timeSpot/timeUnit, static_cast<quint32>(mainResult.strips.size()), timeUnit, tp, sl, mainResult.dayLength);
 		
-		if (oldIt == oldEnd or (newIt != newEnd and newIt->level < oldIt->level))
+		QChartInterface::showPanes(static_cast<quint32>(results.size()));
+		
+		for (auto k = 0u; k < results.size(); ++k)
 		{
-			newIt->lineItem = QChartInterface::candlestickScene->addLine(QChartInterface::candlestickRect.left(), newIt->level, QChartInterface::candlestickRect.right(), newIt->level, pen);
-			newIt->lineItem->setZValue(-90.f);
-			
-			++newIt;
-			continue;
+			const auto pane = QChartInterface::panes[k];
+			pane->scene()->toggleUpdating();
+			pane->setStrips(results[k].strips, results[k].timeSpot, results[k].endSecond, numberOfCandlesticks);
+			pane->setTitle(results.size() > 1u ? results[k].title : "");
 		}
 		
-		newIt->lineItem = oldIt->lineItem;
-		++newIt;
-		++oldIt;
-	}
+		QChartInterface::drawBlackLines();
+		
+		for (auto k = 0u; k < results.size(); ++k)
+			QChartInterface::panes[k]->scene()->toggleUpdating();
+		
+		if (!results.front().report.isEmpty())
+			QChartInterface::appendLog(results.front().report);
+	};
 	
-	QChartInterface::levelPacks.swap(newPacks);
+	QChartInterface::runInBackground<std::vector<HexChartResult>>(job, handler);
 }
 
-void QChartInterface::drawCandlesticks(quint32 sampleTimeSpot, quint32 numberOfCandlesticks, quint32 timeUnit, qreal tp, qreal sl)
+void QChartInterface::exportTrace(void)
 {
-	auto newHexStrips = QChartInterface::savedInformation.extractSample(sampleTimeSpot, numberOfCandlesticks, timeUnit, tp, sl);
-	QChartInterface::candlestickScene->toggleUpdating();
-	QChartInterface::updateCandlesticks(newHexStrips, sampleTimeSpot);
+	const auto timeString = '(' + QTime::currentTime().toString("hh:mm:ss") + ')';
 	
-	QChartInterface::drawTimeLines();
-	QChartInterface::drawBlackLines();
+	if (!HexProfiler::Enabled)
+	{
+		return QChartInterface::appendLog("<p.small>" + timeString + " Profiling is not compiled in, configure with -DHEX_PROFILING=ON.</p>");
+	}
 	
-	QChartInterface::candlestickScene->update();
-	QChartInterface::candlestickScene->setTimeSpot(sampleTimeSpot);
-	QChartInterface::candlestickScene->toggleUpdating();
+	const auto filePath = QFileDialog::getSaveFileName(this, "Export trace", "trace.json", "Chrome trace (*.json)");
+	
+	if (filePath.isEmpty())
+		return;
+	
+	const auto json = HexProfiler::TraceJson();
+	QFile traceFile(filePath);
+	
+	if (!traceFile.open(QIODevice::WriteOnly | QIODevice::Truncate) or traceFile.write(json.data(), static_cast<qint64>(json.size())) != static_cast<qint64>(json.size()))
+		QChartInterface::appendLog("<p.small>" + timeString + " File [" + filePath + "] could not be written.</p>");
+	else
+		QChartInterface::appendLog("<p.small>" + timeString + " Trace written to [" + filePath + "].</p>");
 }
 
-void QChartInterface::drawTimeLines(void)
+// Candlesticks received while a job runs wait in the buffer and go together with the next one, so a fast feed
+// costs one redraw per job instead of one per second. An invalid form still appends, it only skips the redraw; it is
+// checked without logging, since it would otherwise be reported once per job. While the chart shows the previous live
+// sample and no draw came in between, only the strips that changed are sent and repainted.
+void QChartInterface::flushLive(void)
 {
-	auto digit = QChartInterface::sceneItemInfo[0u].timestamp.at(4u);
-	const auto pen = QPen(Qt::black, 0.f, Qt::DotLine);
+	const auto numberOfCandlesticks = QChartInterface::chartSizeEdit->text().toUInt();
+	const auto timeUnit = QChartInterface::timeUnitEdit->text().toUInt();
+	const auto tp = QChartInterface::takeProfitEdit->text().toDouble();
+	const auto sl = QChartInterface::stopLossEdit->text().toDouble();
+	const auto valid = (numberOfCandlesticks >= 100u and numberOfCandlesticks <= 23'400u and timeUnit >= 1u and timeUnit <= 180u and tp >= 0.25 and sl >= 0.);
+	const auto generation = ++QChartInterface::latestDraw;
+	
+	std::vector<std::pair<qreal, qreal>> candlesticks;
+	candlesticks.swap(QChartInterface::liveCandlesticks);
+	QChartInterface::liveJobPending = true;
 	
-	for (const auto& s : QChartInterface::sceneItemInfo)
+	const auto job = [this, candlesticks = std::move(candlesticks), numberOfCandlesticks = (valid ? numberOfCandlesticks : 0u), timeUnit, tp, sl, changesOnly = QChartInterface::liveSampleShown](void)
 	{
-		if (s.timestamp[4u] == digit)
-			continue;
+		return QChartInterface::engine.appendLive(candlesticks, numberOfCandlesticks, timeUnit, tp, sl, changesOnly);
+	};
+	
+	const auto handler = [this, generation](HexChartResult result)
+	{
+		QChartInterface::liveJobPending = false;
 		
-		const auto& rect = s.background->rect();
-		QChartInterface::candlestickScene->addLine(rect.left(), rect.bottom(), rect.left(), rect.top(), pen);
-		digit = s.timestamp[4u];
-	}
+		if (generation != QChartInterface::latestDraw)
+			QChartInterface::liveSampleShown = false;
+		else if (result.completed and !result.strips.empty())
+		{
+			const auto timeSpot = result.strips.back().timeSpot;
+			QChartInterface::mainPane->scene()->toggleUpdating();
+			
+			if (result.firstStrip == 0u)
+			{
+				QChartInterface::showPanes(1u);
+				QChartInterface::mainPane->setTitle("");
+				QChartInterface::mainPane->setStrips(result.strips, timeSpot, result.endSecond, QChartInterface::chartSizeEdit->text().toUInt());
+				QChartInterface::drawBlackLines();
+			}
+			else if (QChartInterface::mainPane->replaceStrips(result.strips, result.firstStrip, timeSpot, result.endSecond, QChartInterface::chartSizeEdit->text().toUInt()))
+				QChartInterface::drawBlackLines();
+			
+			QChartInterface::mainPane->scene()->toggleUpdating();
+			QChartInterface::timeSpotEdit->setText(QString::number(timeSpot));
+			QChartInterface::liveSampleShown = true;
+		}
+		
+		if (!QChartInterface::liveCandlesticks.empty())
+			QChartInterface::flushLive();
+	};
+	
+	QChartInterface::runInBackground<HexChartResult>(job, handler);
+}
+
+// A new current day: the tiles of the previous one are dropped, and those still being rendered are ignored.
+void QChartInterface::forgetTiles(void)
+{
+	++QChartInterface::tileGeneration;
+	QChartInterface::navigator->reset();
 }
 
 void QChartInterface::keyReleaseEvent(QKeyEvent* event)
@@ -378,6 +570,18 @@ void QChartInterface::keyReleaseEvent(QKeyEvent* event)
 			break;
 		}
 		
+		case Qt::Key_F11:
+		{
+			QChartInterface::exportTrace();
+			break;
+		}
+		
+		case Qt::Key_F12:
+		{
+			QChartInterface::toggleProfileOverlay();
+			break;
+		}
+		
 		case Qt::Key_Left:
 		{
 			const auto jump = (QChartInterface::eIBox->isChecked() ? 1u : QChartInterface::timeUnitEdit->text().toUInt());
@@ -393,6 +597,18 @@ void QChartInterface::keyReleaseEvent(QKeyEvent* event)
 			break;
 		}
 		
+		case Qt::Key_PageUp:
+		{
+			QChartInterface::switchDay(-1);
+			break;
+		}
+		
+		case Qt::Key_PageDown:
+		{
+			QChartInterface::switchDay(1);
+			break;
+		}
+		
 		case Qt::Key_Right:
 		{
 			const auto jump = (QChartInterface::eIBox->isChecked() ? 1u : QChartInterface::timeUnitEdit->text().toUInt());
@@ -413,70 +629,104 @@ void QChartInterface::keyReleaseEvent(QKeyEvent* event)
 	}
 }
 
+void QChartInterface::liveStopped(const QString& reason)
+{
+	QChartInterface::appendLog("<p.small>(" + QTime::currentTime().toString("hh:mm:ss") + ") " + reason + "</p>");
+}
+
 void QChartInterface::loadHistory(void)
 {
-	const auto filePath = QFileDialog::getOpenFileName(nullptr, "Load historical data", "input/");
-	QFile dataFile(filePath);
+	QChartInterface::liveFeed->stop();
 	
-	if (!dataFile.open(QIODevice::ReadOnly | QIODevice::Text))
-	{
-		QChartInterface::logBody += "<p.small>(" + QTime::currentTime().toString("hh:mm:ss") + ") Failed to open file.</p>";
-		return QChartInterface::updateInformationPanel();
-	}
-	
-	QTextStream fileReader(&dataFile);
-	const auto minData = fileReader.readLine().split(' ');
-	
-	if (minData.size() != 4u)
-	{
-		QChartInterface::logBody += "<p.small>(" + QTime::currentTime().toString("hh:mm:ss") + ") File [" + filePath + "] has wrong minimum data.</p>";
-		return QChartInterface::updateInformationPanel();
-	}
-	
-	const auto maxData = fileReader.readLine().split(' ');
+	const auto filePath = QFileDialog::getOpenFileName(nullptr, "Load historical data", "input/");
 	
-	if (maxData.size() != 4u)
+	const auto handler = [this](const HexLoadResult& result)
 	{
-		QChartInterface::logBody += "<p.small>(" + QTime::currentTime().toString("hh:mm:ss") + ") File [" + filePath + "] has wrong maximum data.</p>";
-		return QChartInterface::updateInformationPanel();
-	}
-	
-	QChartInterface::savedInformation.setMinima(minData[0u].toDouble(), minData[1u].toDouble(), minData[2u].toDouble(), minData[3u].toDouble());
-	QChartInterface::savedInformation.setMaxima(maxData[0u].toDouble(), maxData[1u].toDouble(), maxData[2u].toDouble(), maxData[3u].toDouble());
-	QChartInterface::savedInformation.clear();
+		if (QChartInterface::reportLoadFailure(result))
+			return;
+		
+		const auto timeString = '(' + QTime::currentTime().toString("hh:mm:ss") + ')';
+		const auto fileName = result.filePath.split('/').back();
+		QChartInterface::fileLabel->setText(fileName);
+		QChartInterface::clearLog();
+		QChartInterface::appendLog("<p.small>" + timeString + " Loaded [" + fileName + "] file.</p><p></p>");
+		QChartInterface::forgetTiles();
+		QChartInterface::appendLog("<p.small>" + timeString + " Chart changed.</p>");
+		
+		QChartInterface::reset();
+	};
 	
-	auto lineCount = 0u;
+	QChartInterface::runInBackground<HexLoadResult>([this, filePath](void) { return QChartInterface::engine.load(filePath); }, handler);
+}
+
+// Logs why a day could not be loaded, if it could not.
+bool QChartInterface::reportLoadFailure(const HexLoadResult& result)
+{
+	const auto timeString = '(' + QTime::currentTime().toString("hh:mm:ss") + ')';
 	
-	while (!fileReader.atEnd())
+	switch (result.report.error)
 	{
-		const auto data = fileReader.readLine().split(' ');
+		case HexParseReport::None:
+			return false;
 		
-		if (data.size() != 2u)
-		{
-			QChartInterface::logBody += "<p.small>(" + QTime::currentTime().toString("hh:mm:ss") + ") File [" + filePath + "] Line " + QString::number(lineCount) + " does not have two integers separated by a space character.</p>";
-			return QChartInterface::updateInformationPanel();
-		}
-		else
-			QChartInterface::savedInformation.saveCandlestick(data[0u].toDouble(), data[1u].toDouble());
+		case HexParseReport::OpenFailure:
+			QChartInterface::appendLog("<p.small>" + timeString + " Failed to open file.</p>");
+			break;
+		
+		case HexParseReport::WrongMinimumData:
+			QChartInterface::appendLog("<p.small>" + timeString + " File [" + result.filePath + "] has wrong minimum data.</p>");
+			break;
+		
+		case HexParseReport::WrongMaximumData:
+			QChartInterface::appendLog("<p.small>" + timeString + " File [" + result.filePath + "] has wrong maximum data.</p>");
+			break;
+		
+		case HexParseReport::MalformedLine:
+			QChartInterface::appendLog("<p.small>" + timeString + " File [" + result.filePath + "] Line " + QString::number(result.report.lineCount) + " does not have two integers separated by a space character.</p>");
+			break;
 		
-		++lineCount;
+		case HexParseReport::InvalidBinaryFile:
+			QChartInterface::appendLog("<p.small>" + timeString + " File [" + result.filePath + "] is not a valid binary day file.</p>");
+			break;
 	}
 	
-	const auto fileName = filePath.split('/').back();
-	QChartInterface::fileLabel->setText(fileName);
-	QChartInterface::logBody = "<p.small>(" + QTime::currentTime().toString("hh:mm:ss") + ") Loaded [" + fileName + "] file.</p><p></p>";
-	QChartInterface::logBody += "<p.small>(" + QTime::currentTime().toString("hh:mm:ss") + ") Chart changed.</p>";
+	return true;
+}
+
+void QChartInterface::receiveCandlestick(qreal low, qreal high)
+{
+	QChartInterface::liveCandlesticks.emplace_back(low, high);
 	
-	QChartInterface::reset();
-	QChartInterface::updateInformationPanel();
+	if (!QChartInterface::liveJobPending)
+		QChartInterface::flushLive();
 }
 
-QRectF QChartInterface::NonFlatRectangle(const QRectF& rect)
+// The strips come from the engine in order, then the tiles are painted in parallel on the global pool.
+void QChartInterface::renderTiles(const QList<QChartTileKey>& keys)
 {
-	if (rect.height() != 0.f)
-		return rect;
+	const auto generation = QChartInterface::tileGeneration;
+	const auto& key = keys.front();
+	std::vector<quint32> indices;
+	
+	for (const auto& k : keys)
+		indices.push_back(k.index);
 	
-	return QRectF(rect.left(), rect.top() - 0.02f, rect.width(), 0.04f);
+	const auto job = [this, key, indices](void)
+	{
+		const auto strips = QChartInterface::engine.tiles(indices, key.stripsPerTile(), key.timeUnit, key.takeProfit, key.stopLoss);
+		return QtConcurrent::blockingMapped<std::vector<QChartTile>>(strips, [key](const std::vector<HexStrip>& s) { return QChartNavigator::Render(s, key.zoom, key.height); });
+	};
+	
+	const auto handler = [this, generation, keys](const std::vector<QChartTile>& tiles)
+	{
+		if (generation != QChartInterface::tileGeneration)
+			return;
+		
+		for (auto i = 0u; i < tiles.size(); ++i)
+			QChartInterface::navigator->insertTile(keys[i], tiles[i]);
+	};
+	
+	QChartInterface::runInBackground<std::vector<QChartTile>>(job, handler);
 }
 
 void QChartInterface::reset(void)
@@ -498,6 +748,26 @@ void QChartInterface::reset(void)
 		QChartInterface::drawCandlesticks(0u, 200u, 1u, 9., 15.);
 }
 
+template <typename Result, typename Job, typename Handler>
+void QChartInterface::runInBackground(Job&& job, Handler&& handler)
+{
+	++QChartInterface::pendingJobs;
+	QChartInterface::progressBar->show();
+	
+	const auto watcher = new QFutureWatcher<Result>(this);
+	
+	QObject::connect(watcher, &QFutureWatcher<Result>::finished, this, [this, watcher, handler](void)
+	{
+		handler(watcher->result());
+		watcher->deleteLater();
+		
+		if (--QChartInterface::pendingJobs == 0u)
+			QChartInterface::progressBar->hide();
+	});
+	
+	watcher->setFuture(QtConcurrent::run(&(QChartInterface::workerPool), std::forward<Job>(job)));
+}
+
 void QChartInterface::showCandlesticks(void)
 {
 	const auto report = QChartInterface::check();
@@ -522,142 +792,145 @@ void QChartInterface::showNewCandlesticks(const QUrl& url)
 	QChartInterface::timeSpotEdit->setText(str);
 }
 
+void QChartInterface::startLiveSession(const HexColumns& extrema)
+{
+	const auto handler = [this](const HexLoadResult& result)
+	{
+		const auto timeString = '(' + QTime::currentTime().toString("hh:mm:ss") + ')';
+		QChartInterface::fileLabel->setText("Live [" + result.filePath.split('/').back() + ']');
+		QChartInterface::clearLog();
+		QChartInterface::appendLog("<p.small>" + timeString + " Live session on [" + result.filePath + "] started.</p><p></p>");
+		QChartInterface::forgetTiles();
+	};
+	
+	QChartInterface::liveCandlesticks.clear();
+	QChartInterface::runInBackground<HexLoadResult>([this, extrema](void) { return QChartInterface::engine.startLive(extrema, QChartInterface::liveSource); }, handler);
+}
+
 void QChartInterface::study(void)
 {
-	QChartInterface::showCandlesticks();
+	const auto report = QChartInterface::check();
+	
+	if (report.abort)
+		return;
 	
 	const auto timeString = '(' + QTime::currentTime().toString("hh:mm:ss") + ')';
-	QChartInterface::logBody += QChartInterface::savedInformation.sumUpBreaksAndDrops(timeString);
-	QChartInterface::updateInformationPanel();
+	QChartInterface::drawCandlesticks(report.tradeTimeSpot, report.numberOfCandlesticks, report.timeUnit, report.takeProfit, report.stopLoss, timeString);
 }
 
-void QChartInterface::updateCandlesticks(std::vector<HexStrip>& newHexStrips, quint32 timeSpot)
+// Panes beyond the main one are created on first use and hidden rather than deleted, so their scenes are reused.
+void QChartInterface::showPanes(quint32 numberOfPanes)
 {
-	QChartInterface::candlestickScene->clear();
-	QChartInterface::candlestickScene->resetHighlight();
-	QChartInterface::levelPacks.clear();
-	
-	const auto numberOfCandlesticks = QChartInterface::chartSizeEdit->text().toUInt();
-	auto maxHeight = -std::numeric_limits<qreal>::max();
-	auto minHeight = std::numeric_limits<qreal>::max();
+	while (QChartInterface::panes.size() < numberOfPanes)
+	{
+		const auto pane = new QChartPane(QChartInterface::paneArea);
+		pane->scene()->setEdits(QChartInterface::highEdit, QChartInterface::lowEdit, QChartInterface::timestampEdit, QChartInterface::cursorEdit);
+		QChartInterface::paneArea->layout()->addWidget(pane);
+		
+		QChartInterface::connectPane(pane);
+		QChartInterface::panes.push_back(pane);
+	}
 	
-	QPen pen(numberOfCandlesticks <= 150u ? Qt::black : Qt::transparent);
-	pen.setWidth(0);
+	for (auto k = 1u; k < QChartInterface::panes.size(); ++k)
+		QChartInterface::panes[k]->setVisible(k < numberOfPanes);
+}
+
+void QChartInterface::switchDay(qint32 step)
+{
+	QChartInterface::liveFeed->stop();
 	
-	for (auto& s : newHexStrips)
+	const auto handler = [this](const HexLoadResult& result)
 	{
-		const auto candlestick = QChartInterface::candlestickScene->addRect(QChartInterface::NonFlatRectangle(s.rectangle), pen);
-		candlestick->setBrush(s.brush);
-		candlestick->setZValue(1.f);
-		candlestick->setAcceptHoverEvents(true);
+		if (!result.loaded)
+		{
+			if (!result.filePath.isEmpty())
+				QChartInterface::reportLoadFailure(result);
+			
+			return;
+		}
 		
-		if (s.rectangle.top() < minHeight)
-			minHeight = s.rectangle.top();
+		const auto fileName = result.filePath.split('/').back();
+		QChartInterface::fileLabel->setText(fileName);
+		QChartInterface::appendLog("<p.small>(" + QTime::currentTime().toString("hh:mm:ss") + ") Switched to [" + fileName + "] file.</p>");
+		QChartInterface::forgetTiles();
 		
-		if (s.rectangle.bottom() > maxHeight)
-			maxHeight = s.rectangle.bottom();
-	}
+		QChartInterface::showCandlesticks();
+	};
 	
-	auto count = 0;
+	QChartInterface::runInBackground<HexLoadResult>([this, step](void) { return QChartInterface::engine.switchDay(step); }, handler);
+}
+
+// A day file is replayed at a multiple of wall-clock speed; a socket or FIFO is read as the producer writes.
+void QChartInterface::toggleLive(void)
+{
+	if (QChartInterface::liveFeed->isRunning())
+		return QChartInterface::liveFeed->stop();
+	
+	auto accepted = false;
+	const auto source = QInputDialog::getText(this, "Live session", "Day file to replay, local socket or FIFO:", QLineEdit::Normal, QChartInterface::liveSource, &accepted);
 	
-	for (auto& s : newHexStrips)
+	if (!accepted or source.isEmpty())
+		return;
+	
+	auto speed = 1.;
+	
+	if (source.endsWith(".txt") or source.endsWith(".hexd"))
 	{
-		const auto rect = QRectF(static_cast<qreal>(count), minHeight - 5.f, 1.f, maxHeight - minHeight + 10.f);
-		s.background = QChartInterface::candlestickScene->addRect(rect);
-		s.background->setBrush(s.timeSpot != timeSpot ? Qt::white : QColor(204, 255, 204));
-		s.background->setPen(QPen(Qt::transparent));
-		s.background->setZValue(-100.f);
-		s.background->setAcceptHoverEvents(true);
-		++count;
+		speed = QInputDialog::getDouble(this, "Live session", "Replay speed:", 60., 0.01, 23'400., 2, &accepted);
+		
+		if (!accepted)
+			return;
 	}
 	
-	const auto spread = maxHeight - minHeight;
-	minHeight -= spread/20.f;
-	maxHeight += spread/20.f;
-	
-	QChartInterface::candlestickRect = QRectF(-1.f, minHeight, static_cast<qreal>(newHexStrips.size()) + 2.f, maxHeight - minHeight);
-	QChartInterface::candlestickView->fitInView(QChartInterface::candlestickRect);
+	QChartInterface::liveSource = source;
 	
-	const auto leftPos = QChartInterface::candlestickView->mapFromScene(newHexStrips[0u].rectangle.left() + 0.2f, newHexStrips[0u].rectangle.top());
-	const auto rightPos = QChartInterface::candlestickView->mapFromScene(newHexStrips[0u].rectangle.right() - 0.2f, newHexStrips[0u].rectangle.top());
-	const auto mapDifference = rightPos.x() - leftPos.x();
+	if (!QChartInterface::liveFeed->start(source, speed))
+	{
+		QChartInterface::appendLog("<p.small>(" + QTime::currentTime().toString("hh:mm:ss") + ") Live source [" + source + "] could not be opened.</p>");
+	}
+}
+
+// The overlay is opaque, so refreshing it does not repaint the chart below and open a frame of its own.
+void QChartInterface::toggleProfileOverlay(void)
+{
+	if (!HexProfiler::Enabled)
+	{
+		return QChartInterface::appendLog("<p.small>(" + QTime::currentTime().toString("hh:mm:ss") + ") Profiling is not compiled in, configure with -DHEX_PROFILING=ON.</p>");
+	}
 	
-	for (auto& s : newHexStrips)
+	if (QChartInterface::profileOverlay->isVisible())
 	{
-		if (static_cast<quint32>(s.breakOrDrop) <= static_cast<quint32>('Z'))
-		{
-			const auto topLeftPos = QChartInterface::candlestickView->mapFromScene(s.rectangle.left() + 0.2f, s.rectangle.top());
-			const auto topLeftY = QChartInterface::candlestickView->mapToScene(topLeftPos.x(), topLeftPos.y() - mapDifference - mapDifference/2).y();
-			const auto bottomLeftY = QChartInterface::candlestickView->mapToScene(topLeftPos.x(), topLeftPos.y() - mapDifference/2).y();
-			const auto rect = QRectF(s.rectangle.left() + 0.2f, topLeftY, s.rectangle.width() - 0.4f, bottomLeftY - topLeftY);
-			
-			const auto info = QChartInterface::candlestickScene->addRect(rect, pen);
-			info->setZValue(1.f);
-			
-			switch (s.breakOrDrop)
-			{
-				case 'D':
-					info->setBrush(QColor(102, 153, 255));
-					break;
-				
-				case 'W':
-					info->setBrush(QColor(0, 85, 255));
-					break;
-				
-				case 'M':
-					info->setBrush(QColor(0, 42, 127));
-					break;
-				
-				case 'Y':
-					info->setBrush(QColor(0, 0, 0));
-					break;
-			}
-		}
-		else if (static_cast<quint32>(s.breakOrDrop) >= static_cast<quint32>('a'))
-		{
-			const auto bottomLeftPos = QChartInterface::candlestickView->mapFromScene(s.rectangle.left() + 0.2f, s.rectangle.bottom());
-			const auto topLeftY = QChartInterface::candlestickView->mapToScene(bottomLeftPos.x(), bottomLeftPos.y() + mapDifference/2).y();
-			const auto bottomLeftY = QChartInterface::candlestickView->mapToScene(bottomLeftPos.x(), bottomLeftPos.y() + mapDifference + mapDifference/2).y();
-			const auto rect = QRectF(s.rectangle.left() + 0.2f, topLeftY, s.rectangle.width() - 0.4f, bottomLeftY - topLeftY);
-			
-			const auto info = QChartInterface::candlestickScene->addRect(rect, pen);
-			info->setZValue(1.f);
-			
-			switch (s.breakOrDrop)
-			{
-				case 'd':
-					info->setBrush(QColor(255, 102, 102));
-					break;
-				
-				case 'w':
-					info->setBrush(QColor(255, 0, 0));
-					break;
-				
-				case 'm':
-					info->setBrush(QColor(127, 0, 0));
-					break;
-				
-				case 'y':
-					info->setBrush(QColor(0, 0, 0));
-					break;
-			}
-		}
+		QChartInterface::profileTimer->stop();
+		return QChartInterface::profileOverlay->hide();
 	}
 	
-	QChartInterface::sceneItemInfo.swap(newHexStrips);
+	QChartInterface::updateProfileOverlay();
+	QChartInterface::profileOverlay->show();
+	QChartInterface::profileOverlay->raise();
+	QChartInterface::profileTimer->start();
 }
 
-void QChartInterface::updateInformationPanel(void)
+// The last completed frame in milliseconds per timer, then the rolling percentiles of single calls over the ring.
+void QChartInterface::updateProfileOverlay(void)
 {
-	QChartInterface::informationPanel->setText(QChartInterface::logHeader + QChartInterface::logBody + QChartInterface::logFooter);
-	const auto scrollbar = QChartInterface::informationPanel->verticalScrollBar();
-	scrollbar->setValue(scrollbar->maximum());
+	auto text = QString("%1 %2 %3 %4").arg("Frame " + QString::number(HexProfiler::CurrentFrame() - 1u), -40).arg("last ms", 9).arg("p50 us", 10).arg("p99 us", 10);
+	
+	for (const auto& summary : HexProfiler::Summarize())
+	{
+		text += '\n' + QString("%1 %2 %3 %4").arg(QString(summary.name), -40).arg(summary.lastFrame, 9, 'f', 3)
+			.arg(summary.samples.percentile(0.5), 10, 'f', 1).arg(summary.samples.percentile(0.99), 10, 'f', 1);
+	}
+	
+	QChartInterface::profileOverlay->setText(text);
+	QChartInterface::profileOverlay->adjustSize();
 }
 
 void QChartInterface::updateBlackLines(void)
 {
 	QChartInterface::drawBlackLines();
-	QChartInterface::candlestickScene->update();
+	
+	for (const auto pane : QChartInterface::panes)
+		pane->scene()->update();
 }
 
 #endif
@@ -0,0 +1,369 @@
+#ifndef __Q_CHART_NAVIGATOR_HPP__
+#define __Q_CHART_NAVIGATOR_HPP__
+
+// Qt Libraries
+#include <QCache>
+#include <QEvent>
+#include <QGraphicsView>
+#include <QHashFunctions>
+#include <QImage>
+#include <QList>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QTimer>
+#include <QTransform>
+#include <QWheelEvent>
+#include <QWidget>
+
+// Standard Libraries
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+// Personal Libraries
+#include "QCandlestickItem.hpp"
+
+// A rendered tile and the prices its image spans, from its bottom row to its top row.
+struct QChartTile
+{
+	QImage				image;
+	qreal				low = 0.;
+	qreal				high = 0.;
+};
+
+// Tile k of a zoom level holds the strips [k, k + 1) times the strips per tile, drawn 2^zoom pixels wide each, so
+// every tile of a level is the same number of pixels wide whatever the time unit.
+struct QChartTileKey
+{
+	quint32				timeUnit = 1u;
+	qreal				takeProfit = 0.;
+	qreal				stopLoss = 0.;
+	qint32				zoom = 0;
+	quint32				index = 0u;
+	qint32				height = 0;
+	
+	inline bool operator==(const QChartTileKey&) const = default;
+	
+	inline quint32 stripsPerTile(void) const
+	{
+		return (zoom >= 0 ? 256u >> zoom : 256u << -zoom);
+	}
+};
+
+inline size_t qHash(const QChartTileKey& key, size_t seed = 0u)
+{
+	return qHashMulti(seed, key.timeUnit, key.takeProfit, key.stopLoss, key.zoom, key.index, key.height);
+}
+
+// Wheel zoom and drag pan over the whole day. While the user navigates, this overlay covers the chart view with
+// tiles of the day that are rendered off the GUI thread and cached, so a step only composites images. Once the
+// navigation pauses, it asks for the exact chart of the window it shows and hides again when that chart is drawn.
+class QChartNavigator : public QWidget
+{
+	Q_OBJECT
+	
+	private:
+	
+		static constexpr qint32			MinimumZoom = -8;
+		static constexpr qint32			MaximumZoom = 4;
+		
+		QGraphicsView* const			view;
+		QTimer* const				settleTimer = new QTimer(this);
+		QCache<QChartTileKey, QChartTile>	tiles;
+		QList<QChartTileKey>			pendingTiles;
+		
+		qreal					firstStrip = 0.;
+		qreal					pixelsPerStrip = 1.;
+		qreal					takeProfit = 0.;
+		qreal					stopLoss = 0.;
+		qreal					dragX = 0.;
+		quint32					timeUnit = 1u;
+		quint32					dayStrips = 0u;
+		bool					dragging = false;
+		
+		inline void				navigate(void);
+		inline void				requestTiles(void);
+		inline QChartTileKey			tileKey(quint32) const;
+		inline std::pair<quint32, quint32>	visibleTiles(qint32) const;
+	
+	signals:
+	
+		void					tilesMissing(const QList<QChartTileKey>&);
+		void					windowChosen(quint32, quint32);
+	
+	protected:
+	
+		inline bool				eventFilter(QObject*, QEvent*) override;
+		inline void				paintEvent(QPaintEvent*) override;
+	
+	public:
+	
+		inline					QChartNavigator(QGraphicsView*);
+		
+		inline static QChartTile		Render(const std::vector<HexStrip>&, qint32, qint32);
+		
+		inline void				insertTile(const QChartTileKey&, const QChartTile&);
+		inline void				reset(void);
+		inline void				setChart(quint32, quint32, quint32, qreal, qreal, quint32);
+};
+
+QChartNavigator::QChartNavigator(QGraphicsView* chartView) : QWidget(chartView), view(chartView)
+{
+	QChartNavigator::tiles.setMaxCost(64 * 1'024);
+	QChartNavigator::settleTimer->setSingleShot(true);
+	QChartNavigator::settleTimer->setInterval(300);
+	QWidget::setGeometry(chartView->viewport()->geometry());
+	QWidget::hide();
+	
+	chartView->viewport()->installEventFilter(this);
+	QWidget::installEventFilter(this);
+	
+	QObject::connect(QChartNavigator::settleTimer, &QTimer::timeout, this, [this](void)
+	{
+		const auto numberOfCandlesticks = std::clamp(static_cast<quint32>(std::lround(QWidget::width()/QChartNavigator::pixelsPerStrip)) - 2u, 100u, 23'400u);
+		const auto first = static_cast<quint32>(std::max(std::lround(QChartNavigator::firstStrip) + 1l, 0l));
+		emit QChartNavigator::windowChosen(first*QChartNavigator::timeUnit + (numberOfCandlesticks*QChartNavigator::timeUnit)/5u, numberOfCandlesticks);
+	});
+}
+
+// The wheel zooms around the strip under the cursor and a left drag pans. Both work on the chart view, which hands
+// over to the overlay as soon as the navigation starts.
+bool QChartNavigator::eventFilter(QObject* watched, QEvent* event)
+{
+	if (event->type() == QEvent::Resize and watched == QChartNavigator::view->viewport())
+		QWidget::setGeometry(QChartNavigator::view->viewport()->geometry());
+	
+	if (QChartNavigator::dayStrips == 0u)
+		return false;
+	
+	switch (event->type())
+	{
+		case QEvent::Wheel:
+		{
+			const auto wheelEvent = static_cast<QWheelEvent*>(event);
+			const auto x = wheelEvent->position().x();
+			const auto width = static_cast<qreal>(QWidget::width());
+			const auto anchor = QChartNavigator::firstStrip + x/QChartNavigator::pixelsPerStrip;
+			const auto zoom = std::pow(1.25, wheelEvent->angleDelta().y()/120.);
+			
+			QChartNavigator::pixelsPerStrip = std::clamp(QChartNavigator::pixelsPerStrip*zoom, width/(std::max(QChartNavigator::dayStrips, 100u) + 2.), width/102.);
+			QChartNavigator::firstStrip = anchor - x/QChartNavigator::pixelsPerStrip;
+			QChartNavigator::navigate();
+			return true;
+		}
+		
+		case QEvent::MouseButtonPress:
+		{
+			const auto mouseEvent = static_cast<QMouseEvent*>(event);
+			
+			if (mouseEvent->button() != Qt::LeftButton)
+				return false;
+			
+			QChartNavigator::dragging = true;
+			QChartNavigator::dragX = mouseEvent->position().x();
+			return true;
+		}
+		
+		case QEvent::MouseMove:
+		{
+			const auto mouseEvent = static_cast<QMouseEvent*>(event);
+			
+			if (!QChartNavigator::dragging)
+				return false;
+			
+			QChartNavigator::firstStrip -= (mouseEvent->position().x() - QChartNavigator::dragX)/QChartNavigator::pixelsPerStrip;
+			QChartNavigator::dragX = mouseEvent->position().x();
+			QChartNavigator::navigate();
+			return true;
+		}
+		
+		case QEvent::MouseButtonRelease:
+		{
+			if (!QChartNavigator::dragging)
+				return false;
+			
+			QChartNavigator::dragging = false;
+			QChartNavigator::settleTimer->start();
+			return true;
+		}
+		
+		default:
+			return false;
+	}
+}
+
+// Tiles may arrive once the navigation is over; they stay cached for the next one.
+void QChartNavigator::insertTile(const QChartTileKey& key, const QChartTile& tile)
+{
+	QChartNavigator::pendingTiles.removeAll(key);
+	QChartNavigator::tiles.insert(key, new QChartTile(tile), std::max<qsizetype>(tile.image.sizeInBytes()/1'024, 1));
+	
+	if (QWidget::isVisible())
+		QWidget::update();
+}
+
+void QChartNavigator::navigate(void)
+{
+	const auto visibleStrips = QWidget::width()/QChartNavigator::pixelsPerStrip;
+	QChartNavigator::firstStrip = std::clamp(QChartNavigator::firstStrip, -1., std::max(QChartNavigator::dayStrips + 1. - visibleStrips, -1.));
+	
+	if (!QWidget::isVisible())
+		QWidget::show();
+	
+	QChartNavigator::requestTiles();
+	QChartNavigator::settleTimer->start();
+	QWidget::update();
+}
+
+// Tiles of the level at or above the current zoom, stretched down to it, so nothing is ever scaled up. The price
+// range is the one of the tiles on screen, each tile drawn into the part of it that its own prices span.
+void QChartNavigator::paintEvent(QPaintEvent*)
+{
+	QPainter painter(this);
+	painter.fillRect(QWidget::rect(), Qt::white);
+	
+	const auto zoom = QChartNavigator::tileKey(0u).zoom;
+	const auto [firstTile, lastTile] = QChartNavigator::visibleTiles(0);
+	std::vector<std::pair<quint32, const QChartTile*>> shownTiles;
+	auto low = std::numeric_limits<qreal>::max();
+	auto high = -std::numeric_limits<qreal>::max();
+	
+	for (auto k = firstTile; k <= lastTile; ++k)
+	{
+		const auto tile = QChartNavigator::tiles.object(QChartNavigator::tileKey(k));
+		
+		if (tile == nullptr or tile->image.isNull())
+			continue;
+		
+		shownTiles.emplace_back(k, tile);
+		low = std::min(low, tile->low);
+		high = std::max(high, tile->high);
+	}
+	
+	if (shownTiles.empty())
+		return;
+	
+	const auto stripsPerTile = QChartNavigator::tileKey(0u).stripsPerTile();
+	const auto tilePixelsPerStrip = std::ldexp(1., zoom);
+	const auto pixelsPerPrice = QWidget::height()/(high - low);
+	painter.setRenderHint(QPainter::SmoothPixmapTransform);
+	
+	for (const auto& [k, tile] : shownTiles)
+	{
+		const auto left = (static_cast<qreal>(k)*stripsPerTile - QChartNavigator::firstStrip)*QChartNavigator::pixelsPerStrip;
+		const auto width = tile->image.width()/tilePixelsPerStrip*QChartNavigator::pixelsPerStrip;
+		const auto top = (high - tile->high)*pixelsPerPrice;
+		painter.drawImage(QRectF(left, top, width, (tile->high - tile->low)*pixelsPerPrice), tile->image);
+	}
+}
+
+// Tiles on both sides of the screen are asked for too, so a short pan finds them ready.
+void QChartNavigator::requestTiles(void)
+{
+	const auto [firstTile, lastTile] = QChartNavigator::visibleTiles(1);
+	QList<QChartTileKey> missingTiles;
+	
+	for (auto k = firstTile; k <= lastTile; ++k)
+	{
+		const auto key = QChartNavigator::tileKey(k);
+		
+		if (!QChartNavigator::tiles.contains(key) and !QChartNavigator::pendingTiles.contains(key))
+			missingTiles.append(key);
+	}
+	
+	if (missingTiles.isEmpty())
+		return;
+	
+	QChartNavigator::pendingTiles.append(missingTiles);
+	emit QChartNavigator::tilesMissing(missingTiles);
+}
+
+// Called from a worker thread: the chart item only paints into the image, it is never part of a scene.
+QChartTile QChartNavigator::Render(const std::vector<HexStrip>& strips, qint32 zoom, qint32 height)
+{
+	HEX_PROFILE_SCOPE("QChartNavigator::Render");
+	QChartTile tile;
+	
+	if (strips.empty() or height <= 0)
+		return tile;
+	
+	auto low = std::numeric_limits<qreal>::max();
+	auto high = -std::numeric_limits<qreal>::max();
+	
+	for (const auto& s : strips)
+	{
+		low = std::min(low, s.low);
+		high = std::max(high, s.high);
+	}
+	
+	const auto spread = std::max(high - low, 1.);
+	tile.low = low - spread/20.;
+	tile.high = high + spread/20.;
+	
+	const auto pixelsPerStrip = std::ldexp(1., zoom);
+	const auto pixelsPerPrice = height/(tile.high - tile.low);
+	tile.image = QImage(std::max(static_cast<qint32>(std::ceil(static_cast<qreal>(strips.size())*pixelsPerStrip)), 1), height, QImage::Format_RGB32);
+	tile.image.fill(Qt::white);
+	
+	QCandlestickItem chart;
+	chart.setStrips(strips, std::numeric_limits<quint32>::max(), (QCandlestickItem::BodyWidth - 0.4f)*pixelsPerStrip/pixelsPerPrice, false);
+	
+	QPainter painter(&tile.image);
+	painter.setTransform(QTransform(pixelsPerStrip, 0., 0., pixelsPerPrice, 0., tile.high*pixelsPerPrice));
+	chart.paintChart(&painter);
+	return tile;
+}
+
+// A new day: the tiles of the previous one are dropped and navigation waits for its first chart.
+void QChartNavigator::reset(void)
+{
+	QChartNavigator::tiles.clear();
+	QChartNavigator::pendingTiles.clear();
+	QChartNavigator::settleTimer->stop();
+	QChartNavigator::dayStrips = 0u;
+	QChartNavigator::dragging = false;
+	QWidget::hide();
+}
+
+// The exact chart that was just drawn, whose strips span the view with one strip of margin on both sides. It ends
+// the navigation unless the user went on meanwhile.
+void QChartNavigator::setChart(quint32 first, quint32 numberOfStrips, quint32 unit, qreal tp, qreal sl, quint32 dayLength)
+{
+	QChartNavigator::timeUnit = unit;
+	QChartNavigator::takeProfit = tp;
+	QChartNavigator::stopLoss = sl;
+	QChartNavigator::dayStrips = (dayLength + unit - 1u)/unit;
+	
+	if (QChartNavigator::settleTimer->isActive() or QChartNavigator::dragging)
+		return;
+	
+	QChartNavigator::firstStrip = static_cast<qreal>(first) - 1.;
+	QChartNavigator::pixelsPerStrip = QWidget::width()/(numberOfStrips + 2.);
+	QWidget::hide();
+}
+
+QChartTileKey QChartNavigator::tileKey(quint32 index) const
+{
+	QChartTileKey key;
+	key.timeUnit = QChartNavigator::timeUnit;
+	key.takeProfit = QChartNavigator::takeProfit;
+	key.stopLoss = QChartNavigator::stopLoss;
+	key.zoom = std::clamp(static_cast<qint32>(std::ceil(std::log2(QChartNavigator::pixelsPerStrip))), QChartNavigator::MinimumZoom, QChartNavigator::MaximumZoom);
+	key.index = index;
+	key.height = QWidget::height();
+	return key;
+}
+
+// The first and last tiles on screen, widened by a number of tiles on both sides and kept within the day.
+std::pair<quint32, quint32> QChartNavigator::visibleTiles(qint32 extra) const
+{
+	const auto stripsPerTile = static_cast<qreal>(QChartNavigator::tileKey(0u).stripsPerTile());
+	const auto lastOfDay = static_cast<qint32>((std::max(QChartNavigator::dayStrips, 1u) - 1u)/static_cast<quint32>(stripsPerTile));
+	const auto first = static_cast<qint32>(std::floor(std::max(QChartNavigator::firstStrip, 0.)/stripsPerTile)) - extra;
+	const auto last = static_cast<qint32>(std::floor((QChartNavigator::firstStrip + QWidget::width()/QChartNavigator::pixelsPerStrip)/stripsPerTile)) + extra;
+	return { static_cast<quint32>(std::clamp(first, 0, lastOfDay)), static_cast<quint32>(std::clamp(last, 0, lastOfDay)) };
+}
+
+#endif
@@ -0,0 +1,179 @@
+#ifndef __Q_CHART_PANE_HPP__
+#define __Q_CHART_PANE_HPP__
+
+// Qt Libraries
+#include <QGraphicsView>
+#include <QLabel>
+#include <QVBoxLayout>
+#include <QWidget>
+
+// Standard Libraries
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+// Personal Libraries
+#include "QCustomGraphicsScene.hpp"
+
+// One chart of the window: a title, the view and the scene with the strips they show. Panes of different instruments
+// share the time axis, so hovering a strip in one highlights the strip of the same session second in the others.
+class QChartPane : public QWidget
+{
+	Q_OBJECT
+	
+	private:
+	
+		QLabel* const				titleLabel = new QLabel(this);
+		QGraphicsView* const			candlestickView = new QGraphicsView(this);
+		QCustomGraphicsScene* const		candlestickScene = new QCustomGraphicsScene(this, sceneItemInfo);
+		
+		std::vector<HexStrip>			sceneItemInfo;
+		QRectF					candlestickRect;
+		qint64					endSecond = 0;
+		
+		inline static QRectF			ChartRect(const std::vector<HexStrip>&);
+	
+	signals:
+	
+		void					secondHovered(qint64);
+	
+	public:
+	
+		inline					QChartPane(QWidget* = nullptr);
+		
+		inline const QRectF&			chartRect(void) const;
+		inline void				highlightSecond(qint64);
+		inline bool				replaceStrips(const std::vector<HexStrip>&, quint32, quint32, quint32, quint32);
+		inline QCustomGraphicsScene*		scene(void) const;
+		inline void				setStrips(std::vector<HexStrip>&, quint32, quint32, quint32);
+		inline void				setTitle(const QString&);
+		inline QGraphicsView*			view(void) const;
+};
+
+QChartPane::QChartPane(QWidget* parent) : QWidget(parent)
+{
+	QChartPane::titleLabel->hide();
+	
+	QChartPane::candlestickView->setScene(QChartPane::candlestickScene);
+	QChartPane::candlestickView->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+	QChartPane::candlestickView->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+	QChartPane::candlestickView->setViewportUpdateMode(QGraphicsView::NoViewportUpdate);
+	QChartPane::candlestickView->setFocusPolicy(Qt::NoFocus);
+	
+	const auto layout = new QVBoxLayout();
+	layout->setContentsMargins(0, 0, 0, 0);
+	layout->setSpacing(2);
+	layout->addWidget(QChartPane::titleLabel);
+	layout->addWidget(QChartPane::candlestickView, 1);
+	QWidget::setLayout(layout);
+	
+	QObject::connect(QChartPane::candlestickScene, &QCustomGraphicsScene::stripHovered, this, [this](qint32 index)
+	{
+		emit QChartPane::secondHovered(index >= 0 ? static_cast<qint64>(QChartPane::sceneItemInfo[static_cast<quint32>(index)].second) : -1);
+	});
+}
+
+// The price range of the strips with a twentieth of margin on each side, and a strip of margin on the left and right.
+QRectF QChartPane::ChartRect(const std::vector<HexStrip>& strips)
+{
+	auto maxHeight = -std::numeric_limits<qreal>::max();
+	auto minHeight = std::numeric_limits<qreal>::max();
+	
+	for (const auto& s : strips)
+	{
+		if (-s.high < minHeight)
+			minHeight = -s.high;
+		
+		if (-s.low > maxHeight)
+			maxHeight = -s.low;
+	}
+	
+	const auto spread = maxHeight - minHeight;
+	minHeight -= spread/20.f;
+	maxHeight += spread/20.f;
+	
+	return QRectF(-1.f, minHeight, static_cast<qreal>(strips.size()) + 2.f, maxHeight - minHeight);
+}
+
+const QRectF& QChartPane::chartRect(void) const
+{
+	return QChartPane::candlestickRect;
+}
+
+// The strip holding that session second, or none for a negative one or one at or past the end of the last strip. The
+// scene forgets its own hovered strip, so moving back over it highlights it again.
+void QChartPane::highlightSecond(qint64 second)
+{
+	auto index = -1;
+	
+	if (second >= 0 and second < QChartPane::endSecond)
+	{
+		const auto after = std::upper_bound(QChartPane::sceneItemInfo.begin(), QChartPane::sceneItemInfo.end(), second, [](qint64 s, const HexStrip& strip) { return s < strip.second; });
+		index = static_cast<qint32>(after - QChartPane::sceneItemInfo.begin()) - 1;
+	}
+	
+	QChartPane::candlestickScene->resetHighlight();
+	QChartPane::candlestickScene->setHighlight(index);
+}
+
+// The strips from the first one on, as the live feed changes the end of the chart. While the number of strips and the
+// price range stay the same, only the replaced strips are repainted; otherwise the chart is laid out again and true
+// is returned, as the levels then need drawing again.
+bool QChartPane::replaceStrips(const std::vector<HexStrip>& tail, quint32 first, quint32 timeSpot, quint32 end, quint32 numberOfCandlesticks)
+{
+	HEX_PROFILE_SCOPE("QChartPane::replaceStrips");
+	QChartPane::endSecond = end;
+	auto& strips = QChartPane::sceneItemInfo;
+	strips.erase(strips.begin() + std::min<std::size_t>(first, strips.size()), strips.end());
+	strips.insert(strips.end(), tail.begin(), tail.end());
+	
+	if (QChartPane::ChartRect(strips) != QChartPane::candlestickRect)
+	{
+		auto newHexStrips = strips;
+		QChartPane::setStrips(newHexStrips, timeSpot, end, numberOfCandlesticks);
+		return true;
+	}
+	
+	const auto timeSpotStrip = std::find_if(strips.rbegin(), strips.rend(), [timeSpot](const HexStrip& s) { return s.timeSpot == timeSpot; });
+	const auto dirtyRect = QChartPane::candlestickScene->chart()->replaceStrips(tail, first, static_cast<qint32>(strips.rend() - timeSpotStrip) - 1);
+	
+	for (const auto view : QChartPane::candlestickScene->views())
+		view->viewport()->update(view->mapFromScene(dirtyRect).boundingRect().adjusted(-2, -2, 2, 2));
+	
+	return false;
+}
+
+QCustomGraphicsScene* QChartPane::scene(void) const
+{
+	return QChartPane::candlestickScene;
+}
+
+void QChartPane::setStrips(std::vector<HexStrip>& newHexStrips, quint32 timeSpot, quint32 end, quint32 numberOfCandlesticks)
+{
+	HEX_PROFILE_SCOPE("QChartPane::setStrips");
+	QChartPane::candlestickScene->resetHighlight();
+	QChartPane::endSecond = end;
+	
+	QChartPane::candlestickRect = QChartPane::ChartRect(newHexStrips);
+	QChartPane::candlestickView->fitInView(QChartPane::candlestickRect);
+	
+	const auto& transform = QChartPane::candlestickView->transform();
+	const auto markerHeight = (QCandlestickItem::BodyWidth - 0.4f)*transform.m11()/transform.m22();
+	
+	QChartPane::candlestickScene->chart()->setStrips(newHexStrips, timeSpot, markerHeight, numberOfCandlesticks <= 150u);
+	QChartPane::sceneItemInfo.swap(newHexStrips);
+}
+
+// An empty title hides the label, so a single pane looks as the chart always did.
+void QChartPane::setTitle(const QString& title)
+{
+	QChartPane::titleLabel->setText(title);
+	QChartPane::titleLabel->setVisible(!title.isEmpty());
+}
+
+QGraphicsView* QChartPane::view(void) const
+{
+	return QChartPane::candlestickView;
+}
+
+#endif
@@ -4,16 +4,23 @@
 // Qt Libraries
 #include <QGraphicsScene>
 #include <QGraphicsSceneMouseEvent>
+#include <QGraphicsView>
 #include <QLineEdit>
 #include <QString>
+#include <QTimer>
 
 // Standard Libraries
+#include <limits>
 #include <vector>
 #include <iostream>
 
 // Personal Libraries
 #include "OtherClasses.hpp"
+#include "QCandlestickItem.hpp"
+#include "QHoverItem.hpp"
 
+// A move only works out the hovered strip. The highlight repaints the strips it leaves and enters, and the edits show
+// the latest position at most once per frame.
 class QCustomGraphicsScene : public QGraphicsScene
 {
 	Q_OBJECT
@@ -21,80 +28,80 @@ class QCustomGraphicsScene : public QGraphicsScene
 	private:
 		
 		const std::vector<HexStrip>&	strips;
+		QCandlestickItem* const		chartItem = new QCandlestickItem();
+		QHoverItem* const		hoverItem = new QHoverItem();
+		QTimer* const			editTimer = new QTimer(this);
 		QLineEdit*			highEdit;
 		QLineEdit*			lowEdit;
 		QLineEdit*			timestampEdit;
 		QLineEdit*			cursorEdit;
 		
-		quint32				currentTimeSpot = 0u;
-		qint32				currentHexStrip = -1'000'000;
+		QPointF				cursorPosition;
+		qint32				currentHexStrip = -1;
+		qint32				shownHexStrip = -2;
+		qint32				shownCents = std::numeric_limits<qint32>::min();
 		bool				stopUpdating = false;
+		
+		inline void			showEdits(void);
+	
+	signals:
+	
+		void				stripHovered(qint32);
 	
 	public:
 	
 		inline QCustomGraphicsScene(QObject*, const std::vector<HexStrip>&);
 		
+		inline QCandlestickItem*	chart(void) const;
 		inline void			mouseMoveEvent(QGraphicsSceneMouseEvent*) override;
 		inline void			resetHighlight(void);
 		inline void			setEdits(QLineEdit*, QLineEdit*, QLineEdit*, QLineEdit*);
-		inline void			setTimeSpot(quint32);
+		inline void			setHighlight(qint32);
 		inline void 			toggleUpdating(void);
 };
 
 QCustomGraphicsScene::QCustomGraphicsScene(QObject* parent, const std::vector<HexStrip>& str) : QGraphicsScene(parent), strips(str)
 {
+	QGraphicsScene::addItem(QCustomGraphicsScene::chartItem);
+	QGraphicsScene::addItem(QCustomGraphicsScene::hoverItem);
+	
+	QCustomGraphicsScene::editTimer->setSingleShot(true);
+	QCustomGraphicsScene::editTimer->setInterval(16);
+	QObject::connect(QCustomGraphicsScene::editTimer, &QTimer::timeout, this, &QCustomGraphicsScene::showEdits);
+}
+
+QCandlestickItem* QCustomGraphicsScene::chart(void) const
+{
+	return QCustomGraphicsScene::chartItem;
 }
 
 void QCustomGraphicsScene::mouseMoveEvent(QGraphicsSceneMouseEvent* mouseEvent)
 {
+	HEX_PROFILE_SCOPE("QCustomGraphicsScene::mouseMoveEvent");
+	
 	if (QCustomGraphicsScene::strips.empty() or QCustomGraphicsScene::stopUpdating)
 		return;
 	
-	const auto xValue = static_cast<qint32>(mouseEvent->scenePos().x());;
+	QCustomGraphicsScene::cursorPosition = mouseEvent->scenePos();
+	const auto xValue = QCustomGraphicsScene::chartItem->stripAt(QCustomGraphicsScene::cursorPosition.x());
 	
 	if (xValue != QCustomGraphicsScene::currentHexStrip)
 	{
-		bool shouldUpdate = false;
-		
-		if (QCustomGraphicsScene::currentHexStrip >= 0 and static_cast<quint32>(QCustomGraphicsScene::currentHexStrip) < QCustomGraphicsScene::strips.size())
-		{
-			const auto& strip = QCustomGraphicsScene::strips[QCustomGraphicsScene::currentHexStrip];
-			strip.background->setBrush(strip.timeSpot != QCustomGraphicsScene::currentTimeSpot ? Qt::white : QColor(204, 255, 204));
-			shouldUpdate = true;
-		}
-		
-		if (xValue >= 0 and static_cast<quint32>(xValue) < QCustomGraphicsScene::strips.size())
-		{
-			QCustomGraphicsScene::currentHexStrip = xValue;
-			const auto& strip = QCustomGraphicsScene::strips[static_cast<quint32>(xValue)];
-			
-			strip.background->setBrush(QColor(225, 225, 225));
-			shouldUpdate = true;
-			
-			QCustomGraphicsScene::timestampEdit->setText(strip.timestamp);
-			QCustomGraphicsScene::highEdit->setText(QString::number(strip.high, 'g', 7));
-			QCustomGraphicsScene::lowEdit->setText(QString::number(strip.low, 'g', 7));
-		}
-		else
-		{
-			QCustomGraphicsScene::currentHexStrip = -1'000'000;
-			QCustomGraphicsScene::timestampEdit->setText("");
-			QCustomGraphicsScene::highEdit->setText("");
-			QCustomGraphicsScene::lowEdit->setText("");
-		}
-		
-		if (shouldUpdate)
-			QGraphicsScene::update();
+		QCustomGraphicsScene::currentHexStrip = xValue;
+		QCustomGraphicsScene::setHighlight(xValue);
+		emit QCustomGraphicsScene::stripHovered(xValue);
 	}
 	
-	const auto yValue = static_cast<qreal>(static_cast<qint32>(0.5 - mouseEvent->scenePos().y()*100.)*0.01);
-	const auto value = QString::number(yValue, 'g', yValue > 10'000. ? 7 : 6);
-	QCustomGraphicsScene::cursorEdit->setText(value);
+	if (!QCustomGraphicsScene::editTimer->isActive())
+		QCustomGraphicsScene::editTimer->start();
 }
 
+// Forgets the hovered strip and the values shown for it, so the next move refreshes both.
 void QCustomGraphicsScene::resetHighlight(void)
 {
-	QCustomGraphicsScene::currentHexStrip = -1'000'000;
+	QCustomGraphicsScene::currentHexStrip = -1;
+	QCustomGraphicsScene::shownHexStrip = -2;
+	QCustomGraphicsScene::setHighlight(-1);
 }
 
 void QCustomGraphicsScene::setEdits(QLineEdit* he, QLineEdit* le, QLineEdit* te, QLineEdit* ce)
@@ -105,9 +112,61 @@ void QCustomGraphicsScene::setEdits(QLineEdit* he, QLineEdit* le, QLineEdit* te,
 	QCustomGraphicsScene::cursorEdit = ce;
 }
 
-void QCustomGraphicsScene::setTimeSpot(quint32 ts)
+// The views never update on their own, so only the bounds of the old and new highlights are repainted.
+void QCustomGraphicsScene::setHighlight(qint32 index)
+{
+	const auto newRect = (index >= 0 ? QCustomGraphicsScene::chartItem->stripRect(index) : QRectF());
+	
+	if (newRect == QCustomGraphicsScene::hoverItem->rect())
+		return;
+	
+	const auto oldBounds = QCustomGraphicsScene::hoverItem->boundingRect();
+	QCustomGraphicsScene::hoverItem->setRect(newRect);
+	const auto newBounds = QCustomGraphicsScene::hoverItem->boundingRect();
+	
+	for (const auto view : QGraphicsScene::views())
+		for (const auto& rect : { oldBounds, newBounds })
+			if (!rect.isEmpty())
+				view->viewport()->update(view->mapFromScene(rect).boundingRect().adjusted(-2, -2, 2, 2));
+}
+
+// Only the edits whose value changed since the last frame are set.
+void QCustomGraphicsScene::showEdits(void)
 {
-	QCustomGraphicsScene::currentTimeSpot = ts;
+	HEX_PROFILE_SCOPE("QCustomGraphicsScene::showEdits");
+	
+	if (QCustomGraphicsScene::strips.empty() or QCustomGraphicsScene::stopUpdating)
+		return;
+	
+	const auto index = QCustomGraphicsScene::currentHexStrip;
+	
+	if (index != QCustomGraphicsScene::shownHexStrip)
+	{
+		QCustomGraphicsScene::shownHexStrip = index;
+		
+		if (index >= 0 and static_cast<quint32>(index) < QCustomGraphicsScene::strips.size())
+		{
+			const auto& strip = QCustomGraphicsScene::strips[static_cast<quint32>(index)];
+			QCustomGraphicsScene::timestampEdit->setText(QString::fromStdString(strip.timestamp));
+			QCustomGraphicsScene::highEdit->setText(QString::number(strip.high, 'g', 7));
+			QCustomGraphicsScene::lowEdit->setText(QString::number(strip.low, 'g', 7));
+		}
+		else
+		{
+			QCustomGraphicsScene::timestampEdit->setText("");
+			QCustomGraphicsScene::highEdit->setText("");
+			QCustomGraphicsScene::lowEdit->setText("");
+		}
+	}
+	
+	const auto cents = static_cast<qint32>(0.5 - QCustomGraphicsScene::cursorPosition.y()*100.);
+	
+	if (cents != QCustomGraphicsScene::shownCents)
+	{
+		QCustomGraphicsScene::shownCents = cents;
+		const auto yValue = static_cast<qreal>(cents)*0.01;
+		QCustomGraphicsScene::cursorEdit->setText(QString::number(yValue, 'g', yValue > 10'000. ? 7 : 6));
+	}
 }
 
 void QCustomGraphicsScene::toggleUpdating(void)
@@ -0,0 +1,74 @@
+#ifndef __Q_HOVER_ITEM_HPP__
+#define __Q_HOVER_ITEM_HPP__
+
+// Qt Libraries
+#include <QGraphicsItem>
+#include <QGraphicsScene>
+#include <QGraphicsView>
+#include <QPainter>
+#include <QRectF>
+
+// Standard Libraries
+#include <algorithm>
+
+// The hovered strip, drawn over the chart with a multiply so the bodies beneath keep their colours. Moving it only
+// dirties the strip it leaves and the one it enters.
+class QHoverItem : public QGraphicsItem
+{
+	private:
+	
+		QRectF					stripRect;
+		QRectF					hoverRect;
+	
+	public:
+	
+		inline					QHoverItem(void);
+		
+		inline QRectF				boundingRect(void) const override;
+		inline void				paint(QPainter*, const QStyleOptionGraphicsItem*, QWidget*) override;
+		inline const QRectF&			rect(void) const;
+		inline void				setRect(const QRectF&);
+};
+
+QHoverItem::QHoverItem(void)
+{
+	QGraphicsItem::setZValue(1.);
+	QGraphicsItem::setAcceptedMouseButtons(Qt::NoButton);
+}
+
+QRectF QHoverItem::boundingRect(void) const
+{
+	return QHoverItem::hoverRect;
+}
+
+void QHoverItem::paint(QPainter* painter, const QStyleOptionGraphicsItem*, QWidget*)
+{
+	if (QHoverItem::hoverRect.isEmpty())
+		return;
+	
+	painter->setCompositionMode(QPainter::CompositionMode_Multiply);
+	painter->fillRect(QHoverItem::hoverRect, QColor(225, 225, 225));
+}
+
+// The strip as given, before any widening.
+const QRectF& QHoverItem::rect(void) const
+{
+	return QHoverItem::stripRect;
+}
+
+// A strip narrower than a pixel in a view is widened to one, as the decimated chart does with its columns, so the
+// bounding rect covers all that is painted.
+void QHoverItem::setRect(const QRectF& newRect)
+{
+	QGraphicsItem::prepareGeometryChange();
+	QHoverItem::stripRect = newRect;
+	QHoverItem::hoverRect = newRect;
+	
+	if (newRect.isEmpty() or QGraphicsItem::scene() == nullptr)
+		return;
+	
+	for (const auto view : QGraphicsItem::scene()->views())
+		QHoverItem::hoverRect.setWidth(std::max(QHoverItem::hoverRect.width(), 1./view->transform().m11()));
+}
+
+#endif
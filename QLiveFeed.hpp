@@ -0,0 +1,261 @@
+#ifndef __Q_LIVE_FEED_HPP__
+#define __Q_LIVE_FEED_HPP__
+
+// Qt Libraries
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QLocalSocket>
+#include <QObject>
+#include <QSocketNotifier>
+#include <QString>
+#include <QTimer>
+
+// Standard Libraries
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <string_view>
+
+#ifdef Q_OS_UNIX
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Personal Libraries
+#include "HexBinaryDay.hpp"
+#include "HexTextParser.hpp"
+
+// Candlesticks as they arrive, in the day file format: the minima row, the maxima row, then one "low high" row per
+// second. The source is a local socket, a FIFO, or a day file replayed at a multiple of wall-clock speed.
+class QLiveFeed : public QObject
+{
+	Q_OBJECT
+	
+	private:
+	
+		QLocalSocket* const			localSocket = new QLocalSocket(this);
+		QTimer* const				replayTimer = new QTimer(this);
+		QSocketNotifier*			pipeNotifier = nullptr;
+		
+		HexColumns				extrema;
+		HexColumns				replayDay;
+		QElapsedTimer				replayClock;
+		QByteArray				partialLine;
+		
+		qreal					replaySpeed = 1.;
+		quint32					replayPosition = 0u;
+		quint32					lineCount = 0u;
+		int					pipeReader = -1;
+		int					pipeWriter = -1;
+		bool					running = false;
+		
+		inline void				consume(const QByteArray&);
+		inline bool				parseLine(std::string_view);
+	
+	private slots:
+	
+		inline void				readPipe(void);
+		inline void				readSocket(void);
+		inline void				replay(void);
+	
+	signals:
+	
+		void					candlestickReceived(qreal, qreal);
+		void					extremaReceived(const HexColumns&);
+		void					stopped(const QString&);
+	
+	public:
+	
+		inline					QLiveFeed(QObject* = nullptr);
+		inline					~QLiveFeed(void);
+		
+		inline bool				isRunning(void) const;
+		inline bool				start(const QString&, qreal = 1.);
+		inline void				stop(const QString& = "Live session stopped.");
+};
+
+QLiveFeed::QLiveFeed(QObject* parent) : QObject(parent)
+{
+	QLiveFeed::replayTimer->setInterval(20);
+	
+	QObject::connect(QLiveFeed::replayTimer, &QTimer::timeout, this, &QLiveFeed::replay);
+	QObject::connect(QLiveFeed::localSocket, &QLocalSocket::readyRead, this, &QLiveFeed::readSocket);
+	QObject::connect(QLiveFeed::localSocket, &QLocalSocket::disconnected, this, [this](void) { QLiveFeed::stop("Live source closed."); });
+	QObject::connect(QLiveFeed::localSocket, &QLocalSocket::errorOccurred, this, [this](void) { QLiveFeed::stop("Live source failed: " + QLiveFeed::localSocket->errorString()); });
+}
+
+QLiveFeed::~QLiveFeed(void)
+{
+	QLiveFeed::stop();
+}
+
+// Lines may be split across reads, so the tail without newline waits for the next chunk.
+void QLiveFeed::consume(const QByteArray& data)
+{
+	QLiveFeed::partialLine += data;
+	qsizetype begin = 0;
+	
+	for (auto end = QLiveFeed::partialLine.indexOf('\n'); end >= 0 and QLiveFeed::running; end = QLiveFeed::partialLine.indexOf('\n', begin))
+	{
+		auto line = std::string_view(QLiveFeed::partialLine.constData() + begin, static_cast<std::size_t>(end - begin));
+		begin = end + 1;
+		
+		if (!line.empty() and line.back() == '\r')
+			line.remove_suffix(1u);
+		
+		if (!line.empty() and !QLiveFeed::parseLine(line))
+			return QLiveFeed::stop("Live line " + QString::number(QLiveFeed::lineCount + 1u) + " is malformed.");
+	}
+	
+	QLiveFeed::partialLine.remove(0, begin);
+}
+
+bool QLiveFeed::isRunning(void) const
+{
+	return QLiveFeed::running;
+}
+
+bool QLiveFeed::parseLine(std::string_view line)
+{
+	if (QLiveFeed::lineCount < 2u)
+	{
+		auto& values = (QLiveFeed::lineCount == 0u ? QLiveFeed::extrema.minima : QLiveFeed::extrema.maxima);
+		
+		if (!HexTextParser::ParseFields(line, values))
+			return false;
+		
+		if (++QLiveFeed::lineCount == 2u)
+			emit QLiveFeed::extremaReceived(QLiveFeed::extrema);
+		
+		return true;
+	}
+	
+	std::array<qreal, 2u> data;
+	
+	if (!HexTextParser::ParseFields(line, data))
+		return false;
+	
+	++QLiveFeed::lineCount;
+	emit QLiveFeed::candlestickReceived(data[0u], data[1u]);
+	return true;
+}
+
+void QLiveFeed::readPipe(void)
+{
+#ifdef Q_OS_UNIX
+	char buffer[4'096];
+	auto count = ::read(QLiveFeed::pipeReader, buffer, sizeof(buffer));
+	
+	while (count > 0 and QLiveFeed::running)
+	{
+		QLiveFeed::consume(QByteArray(buffer, static_cast<qsizetype>(count)));
+		count = ::read(QLiveFeed::pipeReader, buffer, sizeof(buffer));
+	}
+#endif
+}
+
+void QLiveFeed::readSocket(void)
+{
+	QLiveFeed::consume(QLiveFeed::localSocket->readAll());
+}
+
+// Sends every candlestick due since the replay started, so a slow event loop catches up instead of drifting.
+void QLiveFeed::replay(void)
+{
+	if (QLiveFeed::lineCount == 0u)
+	{
+		QLiveFeed::lineCount = 2u;
+		QLiveFeed::replayClock.start();
+		emit QLiveFeed::extremaReceived(QLiveFeed::replayDay);
+	}
+	
+	const auto numberOfCandlesticks = static_cast<quint32>(QLiveFeed::replayDay.lows.size());
+	const auto due = std::min(static_cast<quint32>(static_cast<qreal>(QLiveFeed::replayClock.elapsed())*QLiveFeed::replaySpeed/1'000.) + 1u, numberOfCandlesticks);
+	
+	for (; QLiveFeed::replayPosition < due and QLiveFeed::running; ++QLiveFeed::replayPosition)
+		emit QLiveFeed::candlestickReceived(QLiveFeed::replayDay.lows[QLiveFeed::replayPosition], QLiveFeed::replayDay.highs[QLiveFeed::replayPosition]);
+	
+	if (QLiveFeed::replayPosition == numberOfCandlesticks and QLiveFeed::running)
+		QLiveFeed::stop("Replay finished.");
+}
+
+// A .txt or .hexd path is replayed, a socket path is connected to and a FIFO is read as it fills. The socket connects in
+// the background, a failure stops the feed with its reason. The FIFO is also opened for writing by the feed itself, so
+// it does not reach end of file whenever the producer restarts.
+bool QLiveFeed::start(const QString& source, qreal speed)
+{
+	QLiveFeed::stop();
+	QLiveFeed::partialLine.clear();
+	QLiveFeed::lineCount = 0u;
+	
+	if (source.endsWith(".txt") or source.endsWith(".hexd"))
+	{
+		const auto loaded = (source.endsWith(".hexd") ? HexBinaryDay::Load(source, QLiveFeed::replayDay) : HexTextParser::Parse(source, QLiveFeed::replayDay).error == HexParseReport::None);
+		
+		if (!loaded or QLiveFeed::replayDay.lows.empty())
+			return false;
+		
+		QLiveFeed::replaySpeed = std::max(speed, 0.01);
+		QLiveFeed::replayPosition = 0u;
+		QLiveFeed::running = true;
+		QLiveFeed::replayTimer->start();
+		return true;
+	}
+	
+	std::error_code error;
+	const auto status = std::filesystem::status(source.toStdString(), error);
+	
+	if (status.type() == std::filesystem::file_type::socket)
+	{
+		QLiveFeed::running = true;
+		QLiveFeed::localSocket->connectToServer(source, QIODevice::ReadOnly);
+		return true;
+	}
+	
+#ifdef Q_OS_UNIX
+	if (status.type() == std::filesystem::file_type::fifo)
+	{
+		const auto path = source.toLocal8Bit();
+		QLiveFeed::pipeReader = ::open(path.constData(), O_RDONLY | O_NONBLOCK);
+		
+		if (QLiveFeed::pipeReader < 0)
+			return false;
+		
+		QLiveFeed::pipeWriter = ::open(path.constData(), O_WRONLY | O_NONBLOCK);
+		QLiveFeed::pipeNotifier = new QSocketNotifier(QLiveFeed::pipeReader, QSocketNotifier::Read, this);
+		QObject::connect(QLiveFeed::pipeNotifier, &QSocketNotifier::activated, this, &QLiveFeed::readPipe);
+		QLiveFeed::running = true;
+		return true;
+	}
+#endif
+	
+	return false;
+}
+
+void QLiveFeed::stop(const QString& reason)
+{
+	if (!QLiveFeed::running)
+		return;
+	
+	QLiveFeed::running = false;
+	QLiveFeed::replayTimer->stop();
+	QLiveFeed::replayDay.clear();
+	QLiveFeed::localSocket->abort();
+	
+	if (QLiveFeed::pipeNotifier != nullptr)
+	{
+		QLiveFeed::pipeNotifier->deleteLater();
+		QLiveFeed::pipeNotifier = nullptr;
+	}
+#ifdef Q_OS_UNIX
+	for (const auto descriptor : { QLiveFeed::pipeReader, QLiveFeed::pipeWriter })
+		if (descriptor >= 0)
+			::close(descriptor);
+#endif
+	QLiveFeed::pipeReader = -1;
+	QLiveFeed::pipeWriter = -1;
+	
+	emit QLiveFeed::stopped(reason);
+}
+
+#endif
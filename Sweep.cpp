@@ -0,0 +1,102 @@
+// Qt Libraries
+#include <QString>
+#include <QTextStream>
+
+// Standard Libraries
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <thread>
+
+// Personal Libraries
+#include "HexParameterSweep.hpp"
+
+static std::vector<qreal> Range(const char* first, const char* last, const char* step)
+{
+	const auto from = QString(first).toDouble();
+	const auto to = QString(last).toDouble();
+	const auto increment = QString(step).toDouble();
+	
+	std::vector<qreal> values;
+	
+	if (increment <= 0. or to < from)
+		return values;
+	
+	const auto count = static_cast<quint32>(std::floor((to - from)/increment + 1e-9)) + 1u;
+	
+	for (auto i = 0u; i < count; ++i)
+		values.push_back(from + i*increment);
+	
+	return values;
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc < 8)
+	{
+		std::cerr << "Usage: " << argv[0] << " <directory> <tpFrom> <tpTo> <tpStep> <slFrom> <slTo> <slStep> [--threads N] [--days] [--output file.csv]" << std::endl;
+		return 1;
+	}
+	
+	const auto takeProfits = Range(argv[2], argv[3], argv[4]);
+	const auto stopLosses = Range(argv[5], argv[6], argv[7]);
+	
+	if (takeProfits.empty() or stopLosses.empty() or takeProfits.front() < 0.25 or stopLosses.front() < 0.)
+	{
+		std::cerr << "TP must be at least 0.25, SL at least 0, and both ranges must be increasing." << std::endl;
+		return 1;
+	}
+	
+	auto numberOfThreads = std::max(std::thread::hardware_concurrency(), 1u);
+	auto keepDays = false;
+	QString outputPath;
+	
+	for (auto i = 8; i < argc; ++i)
+	{
+		const QString argument = argv[i];
+		
+		if (argument == "--threads" and i + 1 < argc)
+			numberOfThreads = std::max(QString(argv[++i]).toUInt(), 1u);
+		else if (argument == "--days")
+			keepDays = true;
+		else if (argument == "--output" and i + 1 < argc)
+			outputPath = argv[++i];
+		else
+		{
+			std::cerr << "Unknown argument [" << argv[i] << "]." << std::endl;
+			return 1;
+		}
+	}
+	
+	HexParameterSweep sweep(argv[1], takeProfits, stopLosses, keepDays);
+	
+	if (sweep.numberOfDays() == 0u)
+	{
+		std::cerr << "No day file found in [" << argv[1] << "]." << std::endl;
+		return 1;
+	}
+	
+	sweep.run(numberOfThreads);
+	
+	for (const auto& filePath : sweep.failures())
+		std::cerr << "File [" << filePath.toStdString() << "] could not be read." << std::endl;
+	
+	if (outputPath.isEmpty())
+	{
+		QTextStream stream(stdout);
+		sweep.write(stream);
+		return 0;
+	}
+	
+	QFile outputFile(outputPath);
+	
+	if (!outputFile.open(QIODevice::WriteOnly | QIODevice::Text))
+	{
+		std::cerr << "Failed to open [" << outputPath.toStdString() << "]." << std::endl;
+		return 1;
+	}
+	
+	QTextStream stream(&outputFile);
+	sweep.write(stream);
+	return 0;
+}
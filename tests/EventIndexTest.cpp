@@ -0,0 +1,206 @@
+// Qt Libraries
+#include <QString>
+
+// Standard Libraries
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Personal Libraries
+#include "HexDayAnalysis.hpp"
+#include "HexEventIndex.hpp"
+#include "HexReferenceDay.hpp"
+#include "HexTestDays.hpp"
+#include "HexTextParser.hpp"
+
+// The events of the reference study in time order, with the second each candlestick stands for.
+template <typename SecondOf>
+static std::vector<HexEvent> ReferenceEvents(const std::vector<std::uint8_t>& codes, SecondOf&& secondOf)
+{
+	// Study codes index { 'b', 's', 'u', 'B', 'S', 'e' }; the index keeps Buy, Sell, either and uncertainty.
+	static constexpr std::array<std::uint8_t, 6u> outcomes = { 2u, 2u, 3u, 0u, 1u, 2u };
+	
+	std::vector<HexEvent> events;
+	
+	for (auto i = 0u; i < codes.size(); ++i)
+		if ((codes[i] >> 3) != 0u)
+			events.push_back({ i, secondOf(i), static_cast<std::uint8_t>((codes[i] >> 3) - 1u), outcomes[codes[i] & 7u] });
+	
+	return events;
+}
+
+// Counts the queries where the index disagrees with a linear filter of the events: every level and outcome pair over
+// the whole session, random ranges and ranges bounded by the seconds of its own events.
+static quint32 CheckIndex(const HexEventIndex& index, const std::vector<HexEvent>& events, std::mt19937& generator)
+{
+	std::uniform_int_distribution<std::uint32_t> seconds(0u, 23'400u);
+	auto mismatches = (index.size() != events.size() ? 1u : 0u);
+	
+	for (auto level = 0u; level < HexEventIndex::Levels; ++level)
+	{
+		for (auto outcome = 0u; outcome < HexEventIndex::Outcomes; ++outcome)
+		{
+			std::vector<std::pair<std::uint32_t, std::uint32_t>> ranges = { { 0u, 23'401u }, { 11'700u, 11'700u } };
+			
+			for (auto r = 0u; r < 64u; ++r)
+				ranges.push_back(std::minmax(seconds(generator), seconds(generator)));
+			
+			for (const auto& event : index.bucket(level, outcome))
+			{
+				ranges.emplace_back(event.second, event.second);
+				ranges.emplace_back(event.second, event.second + 1u);
+			}
+			
+			for (const auto& [first, last] : ranges)
+			{
+				const auto found = index.range(level, outcome, first, last);
+				std::vector<std::uint32_t> expected;
+				
+				for (const auto& event : events)
+					if (event.level == level and event.outcome == outcome and event.second >= first and event.second < last)
+						expected.push_back(event.index);
+				
+				if (!std::ranges::equal(found, expected, { }, &HexEvent::index))
+					++mismatches;
+			}
+		}
+	}
+	
+	return mismatches;
+}
+
+static constexpr auto LiveStrips = 100u;
+static constexpr auto LiveUnit = 5u;
+
+static bool SameStrips(const std::vector<HexStrip>& a, const std::vector<HexStrip>& b)
+{
+	return std::ranges::equal(a, b, [](const HexStrip& x, const HexStrip& y)
+	{
+		return x.timestamp == y.timestamp and x.low == y.low and x.high == y.high and x.timeSpot == y.timeSpot and x.second == y.second and x.breakOrDrop == y.breakOrDrop and x.shade == y.shade;
+	});
+}
+
+// Takes the strips that changed since the last live sample into the strips the chart keeps, as the chart does, and
+// tells whether they now are the sample the day aggregates afresh.
+static bool CheckLiveSample(HexDayAnalysis& day, std::vector<HexStrip>& shown, qreal tp, qreal sl)
+{
+	auto firstStrip = 0u;
+	const auto tail = day.extractLiveChanges(LiveStrips, LiveUnit, tp, sl, firstStrip);
+	shown.erase(shown.begin() + std::min<std::size_t>(firstStrip, shown.size()), shown.end());
+	shown.insert(shown.end(), tail.begin(), tail.end());
+	
+	const auto last = (day.size() - 1u)/LiveUnit;
+	const auto first = (last + 1u > LiveStrips ? last + 1u - LiveStrips : 0u);
+	return SameStrips(shown, day.extractCandlestickData(first*LiveUnit, last + 1u - first, LiveUnit));
+}
+
+// Whether the day streamed so far has the study codes, and the chart the strips, of the same candlesticks streamed
+// first and studied afterwards in one batch.
+static bool CheckStreamedStudy(const HexDayAnalysis& day, const std::vector<HexStrip>& shown, const HexColumns& columns, qreal tp, qreal sl)
+{
+	const auto& [dMin, wMin, mMin, yMin] = columns.minima;
+	const auto& [dMax, wMax, mMax, yMax] = columns.maxima;
+	HexDayAnalysis fresh;
+	fresh.setMinima(dMin, wMin, mMin, yMin);
+	fresh.setMaxima(dMax, wMax, mMax, yMax);
+	
+	for (auto i = 0u; i < day.size(); ++i)
+		fresh.appendCandlestick(columns.lows[i], columns.highs[i]);
+	
+	fresh.study(tp, sl);
+	return (fresh.studyCodes() == day.studyCodes() and SameStrips(shown, fresh.extractLiveSample(LiveStrips, LiveUnit, tp, sl)));
+}
+
+// Every day file under the input directory, studied from the file and streamed live: the event index of the day must
+// answer every range query like a linear filter of the reference scanner's breaks and drops. The streamed day, with
+// its TP and SL switched for a while mid-stream, must keep the study and strips of a batch study of what it received
+// so far, and end with the study codes of the reference.
+int main(int argc, char *argv[])
+{
+	if (argc < 2)
+	{
+		std::cerr << "Usage: " << argv[0] << " <input directory>" << std::endl;
+		return 1;
+	}
+	
+	static constexpr auto tp = 9.;
+	static constexpr auto sl = 15.;
+	
+	const auto check = [](const QString& filePath, std::size_t f)
+	{
+		HexColumns columns;
+		HexDayAnalysis analysis;
+		HexReferenceDay reference;
+		
+		if (HexTextParser::Parse(filePath, columns).error != HexParseReport::None or HexTextParser::Parse(filePath, analysis).error != HexParseReport::None or
+			HexTextParser::Parse(filePath, reference).error != HexParseReport::None)
+			return HexTestDays::Fail(filePath, "could not be parsed");
+		
+		const auto size = static_cast<std::uint32_t>(columns.lows.size());
+		std::mt19937 generator(static_cast<std::uint32_t>(f));
+		
+		analysis.study(tp, sl);
+		reference.study(tp, sl);
+		
+		const auto codes = reference.studyCodes();
+		const auto fileMismatches = CheckIndex(analysis.events(), ReferenceEvents(codes, [size](std::uint32_t i) { return static_cast<std::uint32_t>(i*23'400u/size); }), generator);
+		
+		const auto& [dMin, wMin, mMin, yMin] = columns.minima;
+		const auto& [dMax, wMax, mMax, yMax] = columns.maxima;
+		HexDayAnalysis liveDay;
+		liveDay.setMinima(dMin, wMin, mMin, yMin);
+		liveDay.setMaxima(dMax, wMax, mMax, yMax);
+		liveDay.study(tp, sl);
+		
+		std::vector<HexStrip> shown;
+		auto liveTp = tp;
+		auto liveSl = sl;
+		auto sampleMismatches = 0u;
+		auto streamMismatches = 0u;
+		
+		for (auto i = 0u; i < size; ++i)
+		{
+			liveDay.appendCandlestick(columns.lows[i], columns.highs[i]);
+			const auto switching = (i == size/3u or i == size/2u);
+			const auto checkpoint = (switching or i % 1'024u == 0u);
+			
+			if ((checkpoint or i % 7u == 0u) and !CheckLiveSample(liveDay, shown, liveTp, liveSl))
+				++sampleMismatches;
+			
+			if (checkpoint and !CheckStreamedStudy(liveDay, shown, columns, liveTp, liveSl))
+				++streamMismatches;
+			
+			if (switching)
+			{
+				liveTp = (i == size/3u ? 4. : tp);
+				liveSl = (i == size/3u ? 4. : sl);
+				liveDay.study(liveTp, liveSl);
+			}
+		}
+		
+		const auto liveMismatches = CheckIndex(liveDay.events(), ReferenceEvents(codes, [](std::uint32_t i) { return i; }), generator);
+		auto failures = 0u;
+		
+		if (fileMismatches != 0u or liveMismatches != 0u)
+			failures += HexTestDays::Fail(filePath, fileMismatches, " file and ", liveMismatches, " live range(s) differ");
+		
+		// The whole day, streamed, counts as one more checkpoint of each kind.
+		if (liveDay.studyCodes() != codes)
+			++streamMismatches;
+		
+		if (!CheckLiveSample(liveDay, shown, tp, sl))
+			++sampleMismatches;
+		
+		if (streamMismatches != 0u)
+			failures += HexTestDays::Fail(filePath, "streamed study differs ", streamMismatches, " time(s) from the batch one");
+		
+		if (sampleMismatches != 0u)
+			failures += HexTestDays::Fail(filePath, sampleMismatches, " live sample(s) differ");
+		
+		return failures;
+	};
+	
+	return (HexTestDays::ForEachDay(argv[1], { "*.txt" }, check) != 0u ? 1 : 0);
+}
@@ -0,0 +1,349 @@
+#ifndef __HEX_REFERENCE_DAY_HPP__
+#define __HEX_REFERENCE_DAY_HPP__
+
+// Qt Libraries
+#include <QString>
+
+// Standard Libraries
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// Personal Libraries
+#include "HexCoreTypes.hpp"
+
+struct HexReferenceCandlestick
+{
+	qreal		low;
+	qreal		high;
+	
+	qreal		levelToBuyOrSell = 0.;
+	char		winningOrder = 'u';
+	char		breakOrDrop = '_';
+	
+	inline HexReferenceCandlestick(qreal l, qreal h) : low(l), high(h)
+	{
+	}
+};
+
+// The study as the first version of HexDayAnalysis ran it: one array of candlesticks, classified and scanned forward
+// candlestick by candlestick until a side reaches its target or its stop. Slow, but obviously right, so the tests hold
+// the current study to it. It is a parser sink like HexDayAnalysis.
+class HexReferenceDay
+{
+	private:
+	
+		std::vector<HexReferenceCandlestick>	candlesticks;
+		HexInfoFile				dInfo;
+		HexInfoFile				wInfo;
+		HexInfoFile				mInfo;
+		HexInfoFile				yInfo;
+		
+		qreal					takeProfit = 0.;
+		qreal					stopLoss = 0.;
+		
+		inline void				appendCouple(QString&, quint32&, quint32) const;
+		inline QString				record(const QString&, const QString&, const std::array<std::vector<quint32>, 4u>&) const;
+		inline void				update(HexReferenceCandlestick&);
+		inline quint32				strictBuyAndSell(std::vector<HexReferenceCandlestick>::const_iterator, qreal, qreal) const;
+		inline quint32				strictSellAndBuy(std::vector<HexReferenceCandlestick>::const_iterator, qreal, qreal) const;
+	
+	public:
+	
+		inline void				clear(void);
+		inline void				saveCandlestick(qreal, qreal);
+		inline void				saveCandlesticks(const qint32*, const qint32*, quint32);
+		inline void				setMaxima(qreal, qreal, qreal, qreal);
+		inline void				setMinima(qreal, qreal, qreal, qreal);
+		inline void				study(qreal, qreal);
+		inline std::vector<std::uint8_t>	studyCodes(void) const;
+		inline QString				sumUpBreaksAndDrops(const QString&) const;
+};
+
+void HexReferenceDay::appendCouple(QString& result, quint32& oldCouple, quint32 count) const
+{
+	const auto timestamp = static_cast<quint32>(count*23'400u/HexReferenceDay::candlesticks.size());
+	const auto hour = 15u + (timestamp + 1'800u)/3'600u;
+	const auto minute = (30u + timestamp/60u) % 60u;
+	const auto newCouple = 100u*hour + minute;
+	
+	if (newCouple != oldCouple)
+	{
+		const QString zeroPadding = (minute < 10u ? "0" : "");
+		result += " <a href=" + QString::number(count) + ">[" + QString::number(hour) + ':' + zeroPadding + QString::number(minute) + "]</a>";
+		oldCouple = newCouple;
+	}
+}
+
+void HexReferenceDay::clear(void)
+{
+	HexReferenceDay::candlesticks.clear();
+}
+
+QString HexReferenceDay::record(const QString& time, const QString& str, const std::array<std::vector<quint32>, 4u>& info) const
+{
+	const auto sum = info[0u].size() + info[1u].size() + info[2u].size() + info[3u].size();
+	
+	if (sum == 0u)
+		return "";
+	
+	QString letterS = (sum > 1u ? "s" : "");
+	QString result = "<p.small>" + time + ' ' + str + ' ' + QString::number(sum) + " occurrence" + letterS + ".</p>";
+	
+	const auto bRatio = static_cast<qreal>(info[0u].size())*100./static_cast<qreal>(sum);
+	result += "<ul><li>Buy wins " + QString::number(bRatio, 'f', 2) + '%';
+	auto oldCouple = 0u;
+	
+	for (const auto& count : info[0u])
+		HexReferenceDay::appendCouple(result, oldCouple, count);
+	
+	const auto sRatio = static_cast<qreal>(info[1u].size())*100./static_cast<qreal>(sum);
+	result += "</li><li>Sell wins " + QString::number(sRatio, 'f', 2) + '%';
+	oldCouple = 0u;
+	
+	for (const auto& count : info[1u])
+		HexReferenceDay::appendCouple(result, oldCouple, count);
+	
+	const auto eRatio = static_cast<qreal>(info[2u].size())*100./static_cast<qreal>(sum);
+	result += "</li><li>Either wins " + QString::number(eRatio, 'f', 2) + '%';
+	oldCouple = 0u;
+	
+	for (const auto& count : info[2u])
+		HexReferenceDay::appendCouple(result, oldCouple, count);
+	
+	const auto uRatio = static_cast<qreal>(info[3u].size())*100./static_cast<qreal>(sum);
+	result += "</li><li>Uncertainty wins " + QString::number(uRatio, 'f', 2) + '%';
+	oldCouple = 0u;
+	
+	for (const auto& count : info[3u])
+		HexReferenceDay::appendCouple(result, oldCouple, count);
+	
+	const auto bPE = HexReferenceDay::takeProfit*(bRatio + eRatio)/100. - HexReferenceDay::stopLoss*sRatio/100.;
+	const auto sPE = HexReferenceDay::takeProfit*(sRatio + eRatio)/100. - HexReferenceDay::stopLoss*bRatio/100.;
+	
+	result += "</li></ul><p.small>" + time + " Profit expectations: " + QString::number(bPE, 'f', 2) + " (Buy) and " + QString::number(sPE, 'f', 2) + " (Sell).</p>";
+	return result;
+}
+
+void HexReferenceDay::saveCandlestick(qreal low, qreal high)
+{
+	HexReferenceDay::candlesticks.emplace_back(low, high);
+}
+
+// Binary days store prices in quarter-point ticks.
+void HexReferenceDay::saveCandlesticks(const qint32* lowTicks, const qint32* highTicks, quint32 count)
+{
+	for (auto i = 0u; i < count; ++i)
+		HexReferenceDay::saveCandlestick(lowTicks[i]*0.25, highTicks[i]*0.25);
+}
+
+void HexReferenceDay::setMaxima(qreal d, qreal w, qreal m, qreal y)
+{
+	HexReferenceDay::dInfo.rawMax = d;
+	HexReferenceDay::wInfo.rawMax = w;
+	HexReferenceDay::mInfo.rawMax = m;
+	HexReferenceDay::yInfo.rawMax = y;
+}
+
+void HexReferenceDay::setMinima(qreal d, qreal w, qreal m, qreal y)
+{
+	HexReferenceDay::dInfo.rawMin = d;
+	HexReferenceDay::wInfo.rawMin = w;
+	HexReferenceDay::mInfo.rawMin = m;
+	HexReferenceDay::yInfo.rawMin = y;
+}
+
+quint32 HexReferenceDay::strictBuyAndSell(std::vector<HexReferenceCandlestick>::const_iterator it, qreal lowerPriceLimit, qreal upperPriceLimit) const
+{
+	const auto end = HexReferenceDay::candlesticks.cend();
+	auto count = 0u;
+	
+	while (it != end and it->high < upperPriceLimit)
+	{
+		if (it->low <= lowerPriceLimit)
+			return 50'000u;
+		
+		++it;
+		++count;
+	}
+	
+	return (it != end and lowerPriceLimit < it->low ? count : 50'000u);
+}
+
+quint32 HexReferenceDay::strictSellAndBuy(std::vector<HexReferenceCandlestick>::const_iterator it, qreal lowerPriceLimit, qreal upperPriceLimit) const
+{
+	const auto end = HexReferenceDay::candlesticks.cend();
+	auto count = 0u;
+	
+	while (it != end and lowerPriceLimit < it->low)
+	{
+		if (upperPriceLimit <= it->high)
+			return 50'000u;
+		
+		++it;
+		++count;
+	}
+	
+	return (it != end and it->high < upperPriceLimit ? count : 50'000u);
+}
+
+void HexReferenceDay::study(qreal tp, qreal sl)
+{
+	HexReferenceDay::takeProfit = tp;
+	HexReferenceDay::stopLoss = sl;
+	
+	HexReferenceDay::dInfo.min = HexReferenceDay::dInfo.rawMin;
+	HexReferenceDay::wInfo.min = HexReferenceDay::wInfo.rawMin;
+	HexReferenceDay::mInfo.min = HexReferenceDay::mInfo.rawMin;
+	HexReferenceDay::yInfo.min = HexReferenceDay::yInfo.rawMin;
+	
+	HexReferenceDay::dInfo.max = HexReferenceDay::dInfo.rawMax;
+	HexReferenceDay::wInfo.max = HexReferenceDay::wInfo.rawMax;
+	HexReferenceDay::mInfo.max = HexReferenceDay::mInfo.rawMax;
+	HexReferenceDay::yInfo.max = HexReferenceDay::yInfo.rawMax;
+	
+	auto it = HexReferenceDay::candlesticks.cbegin();
+	
+	for (auto& cs : HexReferenceDay::candlesticks)
+	{
+		cs.breakOrDrop = '_';
+		HexReferenceDay::update(cs);
+		
+		const auto buyPrice = (cs.breakOrDrop != '_' ? cs.levelToBuyOrSell : cs.high);
+		const auto buy = HexReferenceDay::strictBuyAndSell(it + 1u, buyPrice - sl, buyPrice + tp);
+		
+		const auto sellPrice = (cs.breakOrDrop != '_' ? cs.levelToBuyOrSell : cs.low);
+		const auto sell = HexReferenceDay::strictSellAndBuy(it + 1u, sellPrice - tp, sellPrice + sl);
+		
+		if (buy > sell)
+			cs.winningOrder = (buy > 23'400u ? 'S' : 's');
+		else if (buy < sell)
+			cs.winningOrder = (sell > 23'400u ? 'B' : 'b');
+		else
+			cs.winningOrder = (buy > 23'400u ? 'u' : 'e');
+		
+		++it;
+	}
+}
+
+// The layout of HexDayAnalysis::studyCodes: the outcome in the low three bits and the break or drop code above.
+std::vector<std::uint8_t> HexReferenceDay::studyCodes(void) const
+{
+	static constexpr std::array<char, 9u> breakCodes = { '_', 'D', 'W', 'M', 'Y', 'd', 'w', 'm', 'y' };
+	static constexpr std::array<char, 6u> outcomeCodes = { 'b', 's', 'u', 'B', 'S', 'e' };
+	
+	std::vector<std::uint8_t> codes;
+	codes.reserve(HexReferenceDay::candlesticks.size());
+	
+	for (const auto& cs : HexReferenceDay::candlesticks)
+	{
+		const auto outcome = std::find(outcomeCodes.begin(), outcomeCodes.end(), cs.winningOrder) - outcomeCodes.begin();
+		const auto breakOrDrop = std::find(breakCodes.begin(), breakCodes.end(), cs.breakOrDrop) - breakCodes.begin();
+		codes.push_back(static_cast<std::uint8_t>(outcome | breakOrDrop << 3));
+	}
+	
+	return codes;
+}
+
+QString HexReferenceDay::sumUpBreaksAndDrops(const QString& time) const
+{
+	static const std::array<QString, 8u> titles = { "Day breaks info!", "Week breaks info!", "Month breaks info!", "Year breaks info!",
+							"Day drops info!", "Week drops info!", "Month drops info!", "Year drops info!" };
+	static constexpr std::array<char, 8u> levelCodes = { 'D', 'W', 'M', 'Y', 'd', 'w', 'm', 'y' };
+	
+	std::array<std::array<std::vector<quint32>, 4u>, 8u> levels = { };
+	auto count = 0u;
+	
+	for (const auto& cs : HexReferenceDay::candlesticks)
+	{
+		if (cs.breakOrDrop != '_')
+		{
+			quint32 index = 3u;
+			
+			switch (cs.winningOrder)
+			{
+				case 'B':
+					index = 0u;
+					break;
+				
+				case 'S':
+					index = 1u;
+					break;
+				
+				case 'b':
+				case 'e':
+				case 's':
+					index = 2u;
+					break;
+			}
+			
+			const auto level = std::find(levelCodes.begin(), levelCodes.end(), cs.breakOrDrop) - levelCodes.begin();
+			levels[static_cast<std::size_t>(level)][index].push_back(count);
+		}
+		
+		++count;
+	}
+	
+	QString aftermath = "";
+	
+	for (auto i = 0u; i < 8u; ++i)
+		aftermath += HexReferenceDay::record(time, titles[i], levels[i]);
+	
+	return aftermath;
+}
+
+void HexReferenceDay::update(HexReferenceCandlestick& cs)
+{
+	if (HexReferenceDay::dInfo.min > cs.low)
+	{
+		cs.levelToBuyOrSell = HexReferenceDay::dInfo.min - 0.25;
+		HexReferenceDay::dInfo.min = cs.low;
+		cs.breakOrDrop = 'd';
+		
+		if (HexReferenceDay::wInfo.min > cs.low)
+		{
+			HexReferenceDay::wInfo.min = cs.low;
+			cs.breakOrDrop = 'w';
+			
+			if (HexReferenceDay::mInfo.min > cs.low)
+			{
+				HexReferenceDay::mInfo.min = cs.low;
+				cs.breakOrDrop = 'm';
+				
+				if (HexReferenceDay::yInfo.min > cs.low)
+				{
+					HexReferenceDay::yInfo.min = cs.low;
+					cs.breakOrDrop = 'y';
+				}
+			}
+		}
+	}
+	else if (HexReferenceDay::dInfo.max < cs.high)
+	{
+		cs.levelToBuyOrSell = HexReferenceDay::dInfo.max + 0.25;
+		HexReferenceDay::dInfo.max = cs.high;
+		cs.breakOrDrop = 'D';
+		
+		if (HexReferenceDay::wInfo.max < cs.high)
+		{
+			HexReferenceDay::wInfo.max = cs.high;
+			cs.breakOrDrop = 'W';
+			
+			if (HexReferenceDay::mInfo.max < cs.high)
+			{
+				HexReferenceDay::mInfo.max = cs.high;
+				cs.breakOrDrop = 'M';
+				
+				if (HexReferenceDay::yInfo.max < cs.high)
+				{
+					HexReferenceDay::yInfo.max = cs.high;
+					cs.breakOrDrop = 'Y';
+				}
+			}
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef __HEX_TEST_DAYS_HPP__
+#define __HEX_TEST_DAYS_HPP__
+
+// Qt Libraries
+#include <QDirIterator>
+#include <QString>
+#include <QStringList>
+
+// Standard Libraries
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// The runner the regression tests share: every day file under a directory goes through a check on all cores, and the
+// failures of the checks are counted.
+class HexTestDays
+{
+	private:
+	
+		inline static std::mutex		outputMutex;
+	
+	public:
+	
+		template <typename... Parts>
+		inline static quint32			Fail(const QString&, const Parts&...);
+		template <typename Check>
+		inline static quint32			ForEachDay(const QString&, const QStringList&, Check&&);
+};
+
+// Writes one line about the file under a lock, so lines of different threads do not interleave, and counts as one
+// failure.
+template <typename... Parts>
+quint32 HexTestDays::Fail(const QString& filePath, const Parts&... parts)
+{
+	const std::lock_guard lock(HexTestDays::outputMutex);
+	std::cerr << filePath.toStdString() << ": ";
+	(std::cerr << ... << parts) << std::endl;
+	return 1u;
+}
+
+// The files matching the patterns, in sorted order, each checked once by whichever thread is free. A check takes the
+// file path and its position and returns its failures. No day at all is a failure too.
+template <typename Check>
+quint32 HexTestDays::ForEachDay(const QString& directory, const QStringList& patterns, Check&& check)
+{
+	std::vector<QString> filePaths;
+	QDirIterator it(directory, patterns, QDir::Files, QDirIterator::Subdirectories);
+	
+	while (it.hasNext())
+		filePaths.push_back(it.next());
+	
+	std::sort(filePaths.begin(), filePaths.end());
+	
+	std::atomic<std::size_t> next = 0u;
+	std::atomic<quint32> failures = 0u;
+	
+	{
+		std::vector<std::jthread> workers;
+		
+		for (auto t = std::max(std::thread::hardware_concurrency(), 1u); t > 0u; --t)
+		{
+			workers.emplace_back([&](void)
+			{
+				for (auto f = next++; f < filePaths.size(); f = next++)
+					failures += check(filePaths[f], f);
+			});
+		}
+	}
+	
+	std::cout << filePaths.size() << " days, " << failures << " failures" << std::endl;
+	return (filePaths.empty() ? 1u : failures.load());
+}
+
+#endif
@@ -0,0 +1,102 @@
+// Qt Libraries
+#include <QString>
+
+// Standard Libraries
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+// Personal Libraries
+#include "HexBinaryDay.hpp"
+#include "HexDayAnalysis.hpp"
+#include "HexForwardScan.hpp"
+#include "HexReferenceDay.hpp"
+#include "HexTestDays.hpp"
+#include "HexTextParser.hpp"
+
+template <typename Sink>
+static bool Load(const QString& filePath, Sink& sink)
+{
+	if (filePath.endsWith(".hexd"))
+		return HexBinaryDay::Load(filePath, sink);
+	
+	return (HexTextParser::Parse(filePath, sink).error == HexParseReport::None);
+}
+
+// Counts, for each kernel, the starts where it disagrees with the scalar loop, over the rest of the day and over the
+// window the study scans before its tables take over, for the limits of a buy and of a sell.
+static std::vector<quint32> CheckKernels(const std::vector<std::pair<const char*, HexForwardScan::Kernel>>& kernels, const HexColumns& columns, qreal tp, qreal sl)
+{
+	const auto size = static_cast<quint32>(columns.lows.size());
+	const auto lows = columns.lows.data();
+	const auto highs = columns.highs.data();
+	std::vector<quint32> mismatches(kernels.size(), 0u);
+	
+	for (auto i = 0u; i < size; ++i)
+	{
+		const std::array<std::pair<qreal, qreal>, 2u> limits = { std::pair(highs[i] - sl, highs[i] + tp), std::pair(lows[i] - tp, lows[i] + sl) };
+		
+		for (const auto end : { size, std::min(i + 1u + HexDayAnalysis::ScanWindow, size) })
+		{
+			for (const auto& [lower, upper] : limits)
+			{
+				const auto expected = HexForwardScan::ScalarFirstCrossing(lows, highs, i + 1u, end, lower, upper);
+				
+				for (auto k = 1u; k < kernels.size(); ++k)
+					if (kernels[k].second(lows, highs, i + 1u, end, lower, upper) != expected)
+						++mismatches[k];
+			}
+		}
+	}
+	
+	return mismatches;
+}
+
+// Every day file under the input directory: each forward scan kernel the CPU runs must find the crossings the scalar
+// loop finds, and the study, window and tables together, must give the study codes of the reference scanner.
+int main(int argc, char *argv[])
+{
+	if (argc < 2)
+	{
+		std::cerr << "Usage: " << argv[0] << " <input directory>" << std::endl;
+		return 1;
+	}
+	
+	static const std::array<std::pair<qreal, qreal>, 2u> pairs = { std::pair(2., 3.), std::pair(9., 15.) };
+	
+	const auto kernels = HexForwardScan::Kernels();
+	std::cout << kernels.size() << " kernel(s), " << HexForwardScan::KernelName() << " dispatched" << std::endl;
+	
+	const auto check = [&kernels](const QString& filePath, std::size_t)
+	{
+		HexColumns columns;
+		HexDayAnalysis analysis;
+		HexReferenceDay reference;
+		
+		if (!Load(filePath, columns) or !Load(filePath, analysis) or !Load(filePath, reference))
+			return HexTestDays::Fail(filePath, "could not be loaded");
+		
+		auto failures = 0u;
+		
+		for (const auto& [tp, sl] : pairs)
+		{
+			const auto mismatches = CheckKernels(kernels, columns, tp, sl);
+			
+			for (auto k = 1u; k < kernels.size(); ++k)
+				if (mismatches[k] != 0u)
+					failures += HexTestDays::Fail(filePath, "TP ", tp, " SL ", sl, ": ", mismatches[k], " ", kernels[k].first, " scan(s) differ");
+			
+			analysis.study(tp, sl);
+			reference.study(tp, sl);
+			
+			if (analysis.studyCodes() != reference.studyCodes())
+				failures += HexTestDays::Fail(filePath, "TP ", tp, " SL ", sl, ": study codes differ");
+		}
+		
+		return failures;
+	};
+	
+	return (HexTestDays::ForEachDay(argv[1], { "*.txt", "*.hexd" }, check) != 0u ? 1 : 0);
+}
@@ -0,0 +1,53 @@
+// Qt Libraries
+#include <QString>
+
+// Standard Libraries
+#include <array>
+#include <iostream>
+#include <utility>
+
+// Personal Libraries
+#include "HexDayAnalysis.hpp"
+#include "HexReferenceDay.hpp"
+#include "HexTestDays.hpp"
+#include "HexTextParser.hpp"
+
+// Every day file under the input directory, studied at a few TP/SL pairs by HexDayAnalysis and by the reference
+// scanner: the study codes and the break and drop report must match byte for byte.
+int main(int argc, char *argv[])
+{
+	if (argc < 2)
+	{
+		std::cerr << "Usage: " << argv[0] << " <input directory>" << std::endl;
+		return 1;
+	}
+	
+	static const std::array<std::pair<qreal, qreal>, 4u> pairs = { std::pair(9., 15.), std::pair(4., 4.), std::pair(2.5, 10.), std::pair(20., 5.) };
+	
+	const auto check = [](const QString& filePath, std::size_t)
+	{
+		HexDayAnalysis analysis;
+		HexReferenceDay reference;
+		
+		if (HexTextParser::Parse(filePath, analysis).error != HexParseReport::None or HexTextParser::Parse(filePath, reference).error != HexParseReport::None)
+			return HexTestDays::Fail(filePath, "could not be parsed");
+		
+		auto failures = 0u;
+		
+		for (const auto& [tp, sl] : pairs)
+		{
+			analysis.study(tp, sl);
+			reference.study(tp, sl);
+			
+			const auto sameCodes = (analysis.studyCodes() == reference.studyCodes());
+			const auto sameReport = (QString::fromStdString(analysis.sumUpBreaksAndDrops("(00:00:00)")) == reference.sumUpBreaksAndDrops("(00:00:00)"));
+			
+			if (!sameCodes or !sameReport)
+				failures += HexTestDays::Fail(filePath, "TP ", tp, " SL ", sl, ": ", (sameCodes ? "report" : "study codes"), " differ");
+		}
+		
+		return failures;
+	};
+	
+	return (HexTestDays::ForEachDay(argv[1], { "*.txt" }, check) != 0u ? 1 : 0);
+}